@@ -0,0 +1,23 @@
+#include <nexus/lazy.hpp>
+
+#include <benchmark/benchmark.h>
+#include <memory>
+
+namespace {
+
+// Evaluated once, every other call only passes `std::call_once`.
+auto BM_LazyGetCref(benchmark::State &state) -> void {
+    static std::shared_ptr<nexus::LazyResult<int>> value;
+    if (state.thread_index() == 0) {
+        value = nexus::lazy_eval_rc([]() { return 42; }); // NOLINT
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(value->get_cref());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LazyGetCref)->ThreadRange(1, 16)->UseRealTime();
+
+} // namespace
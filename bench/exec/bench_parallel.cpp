@@ -0,0 +1,138 @@
+#include "nexus/exec/thread.hpp"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <numeric>
+#include <ranges>
+#include <vector>
+
+namespace {
+
+namespace builder = nexus::exec::thread_builder;
+namespace exec = nexus::exec;
+
+/**
+ * @brief Chunks per worker of the manual chunking baseline.
+ *
+ */
+constexpr std::size_t CHUNKS_PER_WORKER = 4;
+
+auto make_pool(std::int64_t workers) {
+    auto cnt = static_cast<std::size_t>(workers);
+    return builder::blank()
+        .max_workers(cnt)
+        .min_workers(cnt)
+        .init_workers(cnt)
+        .build();
+}
+
+auto make_data(std::int64_t size) -> std::vector<double> {
+    auto data = std::vector<double>(static_cast<std::size_t>(size));
+    std::iota(data.begin(), data.end(), 1.0);
+    return data;
+}
+
+/**
+ * @brief Per element work of the benchmarks.
+ *
+ */
+auto work(double val) -> double { return std::sqrt(val) * std::log(val); }
+
+// Serial loop on the calling thread, the baseline.
+auto BM_ParallelSerial(benchmark::State &state) {
+    auto data = make_data(state.range(1));
+
+    for (auto _ : state) {
+        double sum = 0;
+        for (auto val : data) {
+            sum += work(val);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+BENCHMARK(BM_ParallelSerial)
+    ->ArgNames({"workers", "size"})
+    ->ArgsProduct({{0}, {1 << 12, 1 << 16, 1 << 20}})
+    ->UseRealTime();
+
+// Fixed chunks submitted up front, one future per chunk.
+auto BM_ParallelManual(benchmark::State &state) {
+    auto pool = make_pool(state.range(0));
+    auto data = make_data(state.range(1));
+    auto chunks = static_cast<std::size_t>(state.range(0)) * CHUNKS_PER_WORKER;
+    auto step = (data.size() + chunks - 1) / chunks;
+    auto futs = std::vector<std::future<double>>();
+    futs.reserve(chunks);
+
+    for (auto _ : state) {
+        for (std::size_t first = 0; first < data.size(); first += step) {
+            auto last = std::min(first + step, data.size());
+            futs.push_back(pool.submit([&data, first, last]() {
+                double sum = 0;
+                for (auto i = first; i < last; ++i) {
+                    sum += work(data[i]);
+                }
+                return sum;
+            }));
+        }
+
+        double sum = 0;
+        for (auto &fut : futs) {
+            sum += fut.get();
+        }
+        futs.clear();
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+BENCHMARK(BM_ParallelManual)
+    ->ArgNames({"workers", "size"})
+    ->ArgsProduct({{1, 2, 4, 8, 16}, {1 << 12, 1 << 16, 1 << 20}})
+    ->UseRealTime();
+
+// Lazy splitting, the caller runs the first piece.
+auto BM_ParallelReduce(benchmark::State &state) {
+    auto pool = make_pool(state.range(0));
+    auto data = make_data(state.range(1));
+
+    for (auto _ : state) {
+        auto sum =
+            exec::transform_reduce(pool, data, 0.0, std::plus<>(), work);
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+BENCHMARK(BM_ParallelReduce)
+    ->ArgNames({"workers", "size"})
+    ->ArgsProduct({{1, 2, 4, 8, 16}, {1 << 12, 1 << 16, 1 << 20}})
+    ->UseRealTime();
+
+// Element-wise loop, results written in place.
+auto BM_ParallelFor(benchmark::State &state) {
+    auto pool = make_pool(state.range(0));
+    auto data = make_data(state.range(1));
+    auto out = std::vector<double>(data.size());
+
+    for (auto _ : state) {
+        exec::parallel_for(
+            pool, std::views::iota(std::size_t(0), data.size()),
+            [&](std::size_t idx) { out[idx] = work(data[idx]); });
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+BENCHMARK(BM_ParallelFor)
+    ->ArgNames({"workers", "size"})
+    ->ArgsProduct({{1, 2, 4, 8, 16}, {1 << 12, 1 << 16, 1 << 20}})
+    ->UseRealTime();
+
+} // namespace
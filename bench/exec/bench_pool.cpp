@@ -0,0 +1,110 @@
+#include "nexus/exec/policy.hpp"
+#include "nexus/exec/thread.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <latch>
+#include <vector>
+
+namespace {
+
+namespace builder = nexus::exec::thread_builder;
+
+using nexus::exec::TaskPolicy;
+
+constexpr std::int64_t BATCH_SIZE = 1024;
+
+/**
+ * @brief Busy work of `iters` iterations, the task size of the benchmarks.
+ *
+ */
+auto spin(std::int64_t iters) -> void {
+    for (std::int64_t i = 0; i < iters; ++i) {
+        benchmark::DoNotOptimize(i);
+    }
+}
+
+auto make_pool(std::int64_t workers, TaskPolicy policy = TaskPolicy::FIFO) {
+    auto cnt = static_cast<std::size_t>(workers);
+    return builder::blank()
+        .policy(policy)
+        .max_workers(cnt)
+        .min_workers(cnt)
+        .init_workers(cnt)
+        .build();
+}
+
+// Submit one task and wait for its future, the round trip of an idle pool.
+auto BM_PoolSubmitLatency(benchmark::State &state) {
+    auto pool = make_pool(state.range(0));
+    auto iters = state.range(1);
+
+    for (auto _ : state) {
+        pool.submit([iters]() { spin(iters); }).get();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PoolSubmitLatency)
+    ->ArgNames({"workers", "task"})
+    ->ArgsProduct({{1, 2, 4, 8, 16}, {0, 256, 4096}})
+    ->UseRealTime();
+
+// Post a batch of detached tasks and wait for all of them.
+auto BM_PoolThroughput(benchmark::State &state) {
+    auto pool =
+        make_pool(state.range(0), static_cast<TaskPolicy>(state.range(2)));
+    auto iters = state.range(1);
+
+    for (auto _ : state) {
+        auto done = std::latch(BATCH_SIZE);
+        for (std::int64_t i = 0; i < BATCH_SIZE; ++i) {
+            pool.post([iters, &done]() {
+                spin(iters);
+                done.count_down();
+            });
+        }
+        done.wait();
+    }
+
+    state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
+}
+BENCHMARK(BM_PoolThroughput)
+    ->ArgNames({"workers", "task", "policy"})
+    ->ArgsProduct({{1, 2, 4, 8, 16},
+                   {0, 256, 4096},
+                   {static_cast<std::int64_t>(TaskPolicy::FIFO),
+                    static_cast<std::int64_t>(TaskPolicy::STEAL),
+                    static_cast<std::int64_t>(TaskPolicy::RING)}})
+    ->UseRealTime();
+
+// Same batch through one `push_bulk`.
+auto BM_PoolThroughputBulk(benchmark::State &state) {
+    auto pool = make_pool(state.range(0));
+    auto iters = state.range(1);
+    auto tasks = std::vector<nexus::exec::TaskQueue::TaskType>();
+    tasks.reserve(BATCH_SIZE);
+
+    for (auto _ : state) {
+        auto done = std::latch(BATCH_SIZE);
+        for (std::int64_t i = 0; i < BATCH_SIZE; ++i) {
+            tasks.emplace_back(nexus::exec::detail::TaskDetach(),
+                               [iters, &done]() {
+                                   spin(iters);
+                                   done.count_down();
+                               });
+        }
+        pool.push_bulk(tasks);
+        tasks.clear();
+        done.wait();
+    }
+
+    state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
+}
+BENCHMARK(BM_PoolThroughputBulk)
+    ->ArgNames({"workers", "task"})
+    ->ArgsProduct({{1, 2, 4, 8, 16}, {0, 256, 4096}})
+    ->UseRealTime();
+
+} // namespace
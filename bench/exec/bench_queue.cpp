@@ -0,0 +1,101 @@
+#include "nexus/exec/policy.hpp"
+#include "nexus/exec/queue.hpp"
+
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+using nexus::exec::TaskPolicy;
+using nexus::exec::TaskQueue;
+
+constexpr auto POLICIES = std::array{
+    TaskPolicy::FIFO,  TaskPolicy::LIFO, TaskPolicy::PRIO, TaskPolicy::RAND,
+    TaskPolicy::STEAL, TaskPolicy::RING, TaskPolicy::EDF,
+};
+
+constexpr auto POLICY_NAMES = std::array{
+    "fifo", "lifo", "prio", "rand", "steal", "ring", "edf",
+};
+
+static_assert(POLICIES.size() == POLICY_NAMES.size());
+
+constexpr std::int64_t BULK_SIZE = 64;
+
+auto policy_args(benchmark::internal::Benchmark *bench) -> void {
+    bench->ArgName("policy");
+    bench->DenseRange(0, POLICIES.size() - 1);
+}
+
+auto set_policy_label(benchmark::State &state) -> TaskPolicy {
+    auto idx = static_cast<std::size_t>(state.range(0));
+    state.SetLabel(POLICY_NAMES.at(idx));
+
+    return POLICIES.at(idx);
+}
+
+// One push and one pop per iteration, the queue never grows.
+auto BM_QueuePushPop(benchmark::State &state) {
+    auto queue = TaskQueue(set_policy_label(state));
+
+    for (auto _ : state) {
+        queue.post([]() {});
+        auto task = queue.try_pop();
+        benchmark::DoNotOptimize(task);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_QueuePushPop)->Apply(policy_args);
+
+// A batch through `push_bulk` and `pop_bulk`.
+auto BM_QueueBulk(benchmark::State &state) {
+    auto queue = TaskQueue(set_policy_label(state));
+    auto tasks = std::vector<TaskQueue::TaskType>();
+    auto out = std::vector<TaskQueue::TaskType>();
+    tasks.reserve(BULK_SIZE);
+    out.reserve(BULK_SIZE);
+
+    for (auto _ : state) {
+        for (std::int64_t i = 0; i < BULK_SIZE; ++i) {
+            tasks.emplace_back(nexus::exec::detail::TaskDetach(), []() {});
+        }
+        queue.push_bulk(tasks);
+        tasks.clear();
+
+        while (out.size() < BULK_SIZE) {
+            queue.pop_bulk(out, BULK_SIZE, []() { return false; });
+        }
+        out.clear();
+    }
+
+    state.SetItemsProcessed(state.iterations() * BULK_SIZE);
+}
+BENCHMARK(BM_QueueBulk)->Apply(policy_args);
+
+// Every thread pushes and pops on one shared queue.
+auto BM_QueueContended(benchmark::State &state) {
+    static std::unique_ptr<TaskQueue> queue;
+    if (state.thread_index() == 0) {
+        queue = std::make_unique<TaskQueue>(set_policy_label(state));
+    }
+
+    for (auto _ : state) {
+        queue->post([]() {});
+        auto task = queue->try_pop();
+        benchmark::DoNotOptimize(task);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_QueueContended)
+    ->Apply(policy_args)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+} // namespace
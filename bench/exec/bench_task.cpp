@@ -0,0 +1,63 @@
+#include "nexus/exec/task.hpp"
+
+#include <any>
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cstddef>
+
+namespace {
+
+using nexus::exec::Task;
+
+/**
+ * @brief Task capturing `Size` bytes, callables above
+ * `NEXUS_EXEC_TASK_INLINE_SIZE` go to the heap.
+ *
+ */
+template <std::size_t Size> auto BM_TaskConstruct(benchmark::State &state) {
+    auto payload = std::array<char, Size>();
+
+    for (auto _ : state) {
+        auto task = Task<std::any>(
+            [payload]() { return static_cast<int>(payload[0]); });
+        benchmark::DoNotOptimize(task);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TaskConstruct<8>);
+BENCHMARK(BM_TaskConstruct<32>);
+BENCHMARK(BM_TaskConstruct<48>);
+BENCHMARK(BM_TaskConstruct<256>);
+
+template <std::size_t Size>
+auto BM_TaskConstructDetached(benchmark::State &state) {
+    auto payload = std::array<char, Size>();
+
+    for (auto _ : state) {
+        auto task = Task<std::any>(nexus::exec::detail::TaskDetach(),
+                                   [payload]() {
+                                       benchmark::DoNotOptimize(payload[0]);
+                                   });
+        benchmark::DoNotOptimize(task);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TaskConstructDetached<8>);
+BENCHMARK(BM_TaskConstructDetached<256>);
+
+// Construct, call and read the result through the future.
+auto BM_TaskInvoke(benchmark::State &state) {
+    for (auto _ : state) {
+        auto task = Task<std::any>([]() { return 1; });
+        auto fut = task.get_future();
+        task();
+        benchmark::DoNotOptimize(fut.get());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TaskInvoke);
+
+} // namespace
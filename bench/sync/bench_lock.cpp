@@ -0,0 +1,38 @@
+#include "nexus/sync/mutex.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace {
+
+using nexus::sync::Mutex;
+
+// Baseline of `BM_MutexGuard`.
+auto BM_StdMutex(benchmark::State &state) {
+    static std::mutex    lock;
+    static std::uint64_t value = 0;
+
+    for (auto _ : state) {
+        auto guard = std::unique_lock(lock);
+        benchmark::DoNotOptimize(++value);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StdMutex)->ThreadRange(1, 16)->UseRealTime();
+
+auto BM_MutexGuard(benchmark::State &state) {
+    static Mutex<std::uint64_t> value(0);
+
+    for (auto _ : state) {
+        auto guard = value.lock();
+        benchmark::DoNotOptimize(++*guard.get());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MutexGuard)->ThreadRange(1, 16)->UseRealTime();
+
+} // namespace
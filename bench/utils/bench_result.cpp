@@ -0,0 +1,57 @@
+#include "nexus/utils/result.hpp"
+
+#include <benchmark/benchmark.h>
+
+namespace {
+
+using nexus::Err;
+using nexus::Ok;
+using nexus::Result;
+
+using IntResult = Result<int, const char *>;
+
+auto make_result(bool ok) -> IntResult {
+    if (ok) {
+        return Ok(1);
+    }
+    return Err("error");
+}
+
+// Arg 1 runs on `Ok`, arg 0 on `Err`.
+auto BM_ResultMap(benchmark::State &state) {
+    auto ok = state.range(0) != 0;
+
+    for (auto _ : state) {
+        auto res = make_result(ok).map([](int value) { return value + 1; });
+        benchmark::DoNotOptimize(res);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ResultMap)->ArgName("ok")->Arg(0)->Arg(1);
+
+auto BM_ResultBothAnd(benchmark::State &state) {
+    auto ok = state.range(0) != 0;
+
+    for (auto _ : state) {
+        auto res = make_result(ok).both_and(
+            [](int value) -> IntResult { return Ok(value * 2); });
+        benchmark::DoNotOptimize(res);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ResultBothAnd)->ArgName("ok")->Arg(0)->Arg(1);
+
+auto BM_ResultUnwrapOr(benchmark::State &state) {
+    auto ok = state.range(0) != 0;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(make_result(ok).unwrap_or(0));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ResultUnwrapOr)->ArgName("ok")->Arg(0)->Arg(1);
+
+} // namespace
@@ -43,6 +43,7 @@
                     doxygen
 
                     gtest
+                    gbenchmark
                   ])
                   ++ [
                     clang-tools
@@ -13,6 +13,30 @@ enum class TaskPolicy : uint8_t {
     LIFO,
     PRIO,
     RAND,
+    STEAL,
+    RING,
+    EDF,
+};
+
+/**
+ * @brief Worker idle policies, what a worker does when the queue is empty.
+ *
+ */
+enum class IdlePolicy : uint8_t {
+    Block,    // Park on the queue immediately.
+    Spin,     // Spin a fixed number of iterations, then park.
+    Adaptive, // Spin with an adaptive budget, yield, then park.
+};
+
+/**
+ * @brief Deadline miss policies, what a worker does with a task taken after
+ * its deadline.
+ *
+ */
+enum class MissPolicy : uint8_t {
+    Run,    // Run the task anyway.
+    Drop,   // Destroy the task, its future gets `broken_promise`.
+    Handle, // Pass the task to the miss handler of the queue.
 };
 
 } // namespace nexus::exec
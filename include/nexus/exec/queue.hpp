@@ -3,17 +3,24 @@
 #include "nexus/common.hpp"
 #include "nexus/exec/policy.hpp"
 #include "nexus/exec/task.hpp"
+#include "nexus/private/exec/deque.hpp"
+#include "nexus/private/exec/metrics.hpp"
+#include "nexus/private/exec/park.hpp"
 #include "nexus/private/exec/queue.hpp"
 
 #include <any>
 #include <atomic>
-#include <condition_variable>
+#include <chrono>
 #include <cstddef>
+#include <exception>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <span>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace nexus::exec {
 
@@ -41,19 +48,98 @@ class NEXUS_EXPORT TaskQueue {
      */
     using InnerPtr = std::unique_ptr<detail::TaskQueueInner>;
 
+    /**
+     * @brief Handler of errors thrown by detached tasks.
+     *
+     */
+    using ErrorHandler = std::function<void(std::exception_ptr)>;
+
+    /**
+     * @brief Handler of tasks taken after their deadline (`MissPolicy::Handle`
+     * only), it may run, fail or re-route the task.
+     *
+     */
+    using MissHandler = std::function<void(TaskType &&)>;
+
+    /**
+     * @brief Default count of workers owning a local deque (STEAL) or a
+     * sub-queue (RAND).
+     *
+     */
+    constexpr static std::size_t DEFAULT_WORKERS = 16;
+
+    /**
+     * @brief Default capacity of bounded queues (RING only).
+     *
+     */
+    constexpr static std::size_t DEFAULT_CAPACITY = 4096;
+
   private:
-    static const std::unordered_map<TaskPolicy, InnerPtr (*)()>
+    static const std::unordered_map<
+        TaskPolicy, InnerPtr (*)(const detail::TaskQueueConfig &)>
         POLICY_CREATOR; /**< TaskPolicy to specific queue. */
 
     InnerPtr _inner;
 
-    std::mutex              _lock;
-    std::condition_variable _cond;
-    std::atomic_size_t      _size{0};
+    std::mutex         _lock;
+    std::atomic_size_t _size{0};
+    std::atomic_size_t _peak{0};
+
+    /**
+     * @brief Parked threads, each one is woken up through its own slot, so a
+     * push wakes exactly one thread and a cancel only the cancelled worker.
+     * Lock free pushes skip the lock unless someone is parked.
+     *
+     */
+    detail::ParkingLot _parked;
+
+    /**
+     * @brief Pops don't hold `_lock`, workers only park when the
+     * queue is empty (STEAL policy or self synchronized inner queue).
+     *
+     */
+    bool _concurrent{false};
+
+    /**
+     * @brief Per worker deques, only allocated in STEAL policy, `_inner` is
+     * used as the injection queue then.
+     *
+     */
+    std::unique_ptr<detail::WorkerSlot[]> _slots;
+    std::size_t                           _slot_cnt{0};
+    std::atomic_size_t                    _injected{0};
+
+    /**
+     * @brief Attached workers, bounds the share of a batched pop.
+     *
+     */
+    std::atomic_size_t _worker_cnt{0};
+
+    ErrorHandler _error_handler;
+
+    MissPolicy  _miss_policy{MissPolicy::Run};
+    MissHandler _miss_handler;
 
   public:
-    TaskQueue(TaskPolicy policy) : _inner(POLICY_CREATOR.at(policy)()) {}
-    ~TaskQueue() = default;
+    /**
+     * @brief Construct a task queue.
+     *
+     * @param policy Queue policy.
+     * @param workers Max workers owning a local deque (STEAL only), other
+     * workers share the injection queue. Also the sub-queue count of RAND.
+     * @param capacity Queue capacity (RING only), pushes to a full queue
+     * yield until a slot is free, a worker attached to the queue runs queued
+     * tasks inline meanwhile.
+     */
+    TaskQueue(TaskPolicy policy, std::size_t workers = DEFAULT_WORKERS,
+              std::size_t capacity = DEFAULT_CAPACITY);
+
+    /**
+     * @brief Destroy the queue, out of line since the worker slots are
+     * private to the library.
+     *
+     */
+    ~TaskQueue();
 
     TaskQueue(const TaskQueue &other) = delete;
     auto operator=(const TaskQueue &other) -> TaskQueue & = delete;
@@ -68,6 +154,14 @@ class NEXUS_EXPORT TaskQueue {
      */
     auto push(TaskType &&task) -> void;
 
+    /**
+     * @brief Add tasks to the queue under one lock acquisition, and wake up
+     * at most `tasks.size()` sleeping workers.
+     *
+     * @param tasks Task objects, moved into the queue.
+     */
+    auto push_bulk(std::span<TaskType> tasks) -> void;
+
     /**
      * @brief Pop one task (wait until queue is ready).
      *
@@ -75,6 +169,13 @@ class NEXUS_EXPORT TaskQueue {
      */
     auto pop() -> TaskType;
 
+    /**
+     * @brief Pop one task without waiting.
+     *
+     * @return std::optional<TaskType> Task object, empty if queue is empty.
+     */
+    auto try_pop() -> std::optional<TaskType>;
+
     /**
      * @brief Get task count.
      *
@@ -91,10 +192,112 @@ class NEXUS_EXPORT TaskQueue {
     NEXUS_INLINE auto empty() -> bool { return _size.load() == 0; }
 
     /**
-     * @brief Wake up all worker listening on the queue.
+     * @brief Get peak task count since the queue is created.
+     *
+     * @return std::size_t Peak task count.
+     */
+    NEXUS_INLINE auto peak_size() -> std::size_t {
+        return _peak.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get count of threads parked on the queue.
      *
+     * @return std::size_t Parked threads.
      */
-    NEXUS_INLINE auto wakeup_all() -> void { _cond.notify_all(); }
+    NEXUS_INLINE auto parked() -> std::size_t { return _parked.size(); }
+
+    /**
+     * @brief Wake up at most `cnt` threads parked on the queue.
+     *
+     * @param cnt Max threads to wake up.
+     */
+    NEXUS_INLINE auto wakeup(std::size_t cnt = 1) -> void {
+        _wakeup_sleepers(cnt);
+    }
+
+    /**
+     * @brief Wake up all threads parked on the queue.
+     *
+     */
+    NEXUS_INLINE auto wakeup_all() -> void {
+        auto guard = std::lock_guard(_lock);
+        _parked.unpark(_parked.size());
+    }
+
+    /**
+     * @brief Wake up one thread if it is parked on the queue, used to make it
+     * re-check its pred.
+     *
+     * @param parker Parking slot passed to `pop` / `pop_bulk`.
+     */
+    NEXUS_INLINE auto unpark(detail::Parker &parker) -> void {
+        auto guard = std::lock_guard(_lock);
+        _parked.unpark(parker);
+    }
+
+    /**
+     * @brief Set handler of errors thrown by detached tasks, should be set
+     * before workers run.
+     *
+     * @param handler Error handler, errors are dropped if it is empty.
+     */
+    NEXUS_INLINE auto error_handler(ErrorHandler handler) -> void {
+        _error_handler = std::move(handler);
+    }
+
+    /**
+     * @brief Pass error of a detached task to the error handler.
+     *
+     * @param err Error object.
+     */
+    auto handle_error(std::exception_ptr err) -> void;
+
+    /**
+     * @brief Set what workers do with tasks taken after their deadline,
+     * should be set before workers run.
+     *
+     * @param policy Miss policy.
+     * @param handler Miss handler (`MissPolicy::Handle` only), missed tasks
+     * are dropped if it is empty.
+     */
+    NEXUS_INLINE auto miss_policy(MissPolicy policy, MissHandler handler = {})
+        -> void {
+        _miss_policy = policy;
+        _miss_handler = std::move(handler);
+    }
+
+    /**
+     * @brief Apply the miss policy to a task taken after its deadline.
+     *
+     * @param task Missed task, moved out unless it should run.
+     * @return true Task should run.
+     * @return false Task is dropped or handed to the miss handler.
+     */
+    auto handle_miss(TaskType &task) -> bool;
+
+    /**
+     * @brief Attach calling thread to the queue as a worker. In STEAL policy
+     * the thread takes a local deque, tasks pushed by the thread go to the
+     * deque and other workers may steal them.
+     *
+     * @return true Thread owns a local deque.
+     * @return false Policy is not STEAL or all deques are taken.
+     */
+    auto attach() -> bool;
+
+    /**
+     * @brief Detach calling thread from the queue, tasks left in its local
+     * deque are moved to the injection queue.
+     *
+     */
+    auto detach() -> void;
+
+    /**
+     * @brief Check if calling thread is a worker attached to the queue.
+     *
+     */
+    [[nodiscard]] auto attached() const -> bool;
 
     /**
      * @brief Add a task to the queue.
@@ -107,6 +310,21 @@ class NEXUS_EXPORT TaskQueue {
         push(TaskType(std::forward<Args>(args)...));
     }
 
+    /**
+     * @brief Add a detached task to the queue, which has no future, error of
+     * the task is passed to the error handler.
+     *
+     * @tparam F Function type.
+     * @tparam Args Arguments type.
+     * @param func Function.
+     * @param args Arguments.
+     */
+    template <typename F, typename... Args>
+    NEXUS_INLINE auto post(F &&func, Args &&...args) -> void {
+        push(TaskType(detail::TaskDetach(), std::forward<F>(func),
+                      std::forward<Args>(args)...));
+    }
+
     /**
      * @brief  Pop one task (wait until queue is ready or timeout).
      *
@@ -116,12 +334,24 @@ class NEXUS_EXPORT TaskQueue {
     template <typename Rep, typename Period>
     auto pop_for(const std::chrono::duration<Rep, Period> &timeout)
         -> std::optional<TaskType> {
+        auto deadline =
+            std::chrono::steady_clock::now() +
+            std::chrono::ceil<std::chrono::steady_clock::duration>(timeout);
+        auto parker = detail::Parker();
+
+        if (_concurrent) {
+            return _pop_wait(
+                [deadline]() {
+                    return std::chrono::steady_clock::now() >= deadline;
+                },
+                parker, deadline);
+        }
+
         auto guard = std::unique_lock(_lock);
-        auto status =
-            _cond.wait_for(guard, timeout, [this]() { return !this->empty(); });
 
         // Timeout
-        if (!status) {
+        if (!_park(guard, parker, [this]() { return !this->empty(); },
+                   deadline)) {
             return {};
         }
 
@@ -135,34 +365,311 @@ class NEXUS_EXPORT TaskQueue {
      * @return std::optional<TaskType> Task object.
      */
     template <typename F> auto pop(F &&pred) -> std::optional<TaskType> {
-        auto guard = std::unique_lock(_lock);
+        auto parker = detail::Parker();
+        return pop(std::forward<F>(pred), parker);
+    }
 
-        auto is_user_pred = false;
-        _cond.wait(guard,
-                   [this, &is_user_pred, pred = std::forward<F>(pred)]() {
-                       if (pred()) {
-                           is_user_pred = true;
-                           return true;
-                       }
+    /**
+     * @brief  Pop one task (wait until queue is ready or pred).
+     *
+     * @param pred User pred function.
+     * @param parker Parking slot of calling thread, pass it to `unpark` to
+     * make the thread re-check pred.
+     * @return std::optional<TaskType> Task object.
+     */
+    template <typename F>
+    auto pop(F &&pred, detail::Parker &parker) -> std::optional<TaskType> {
+        if (_concurrent) {
+            return _pop_wait(std::forward<F>(pred), parker);
+        }
 
-                       return !this->empty();
-                   });
+        auto guard = std::unique_lock(_lock);
 
         // User pred
-        if (is_user_pred) {
+        if (!_wait_ready(guard, parker, std::forward<F>(pred))) {
             return {};
         }
 
         return _pop_impl();
     }
 
+    /**
+     * @brief Pop a batch of tasks (wait until queue is ready or pred), the
+     * lock and pred are checked once per batch instead of once per task.
+     *
+     * @param out Output buffer, tasks are appended to it.
+     * @param max Max tasks to pop.
+     * @param pred User pred function.
+     * @return std::size_t Tasks popped, 0 if pred is satisfied.
+     *
+     * @note A batch takes at most `1 / workers` of the queued tasks, so one
+     * worker can't hoard the backlog. In STEAL policy only one task is
+     * returned, the rest of the batch goes to the local deque where other
+     * workers can still steal it.
+     */
+    template <typename F>
+    auto pop_bulk(std::vector<TaskType> &out, std::size_t max, F &&pred)
+        -> std::size_t {
+        auto parker = detail::Parker();
+        return pop_bulk(out, max, std::forward<F>(pred), parker);
+    }
+
+    /**
+     * @brief Pop a batch of tasks (wait until queue is ready or pred).
+     *
+     * @param out Output buffer, tasks are appended to it.
+     * @param max Max tasks to pop.
+     * @param pred User pred function.
+     * @param parker Parking slot of calling thread, pass it to `unpark` to
+     * make the thread re-check pred.
+     * @return std::size_t Tasks popped, 0 if pred is satisfied.
+     */
+    template <typename F>
+    auto pop_bulk(std::vector<TaskType> &out, std::size_t max, F &&pred,
+                  detail::Parker &parker) -> std::size_t {
+        if (max <= 1) {
+            auto task = pop(std::forward<F>(pred), parker);
+            if (!task.has_value()) {
+                return 0;
+            }
+
+            out.push_back(std::move(task.value()));
+            return 1;
+        }
+
+        if (_concurrent) {
+            auto task = _pop_wait(std::forward<F>(pred), parker);
+            if (!task.has_value()) {
+                return 0;
+            }
+
+            out.push_back(std::move(task.value()));
+            return 1 + _try_pop_bulk(out, max - 1);
+        }
+
+        auto guard = std::unique_lock(_lock);
+
+        // User pred
+        if (!_wait_ready(guard, parker, std::forward<F>(pred))) {
+            return 0;
+        }
+
+        return _pop_bulk_impl(out, max);
+    }
+
   private:
+    /**
+     * @brief Add to task count and track the peak.
+     *
+     * @param cnt Tasks added.
+     */
+    NEXUS_INLINE auto _add_size(std::size_t cnt) -> void {
+        auto size = _size.fetch_add(cnt) + cnt;
+
+        auto peak = _peak.load(std::memory_order_relaxed);
+        while (size > peak && !_peak.compare_exchange_weak(
+                                  peak, size, std::memory_order_relaxed)) {
+        }
+    }
+
+    /**
+     * @brief Park calling thread until ready or deadline, `_lock` should be
+     * held.
+     *
+     * @param guard Lock guard of `_lock`.
+     * @param parker Parking slot of calling thread.
+     * @param ready Ready pred, checked under the lock.
+     * @param deadline Wait deadline.
+     * @return true Ready is satisfied.
+     * @return false Timeout.
+     */
+    template <typename F>
+    auto _park(std::unique_lock<std::mutex> &guard, detail::Parker &parker,
+               F &&ready,
+               std::chrono::steady_clock::time_point deadline =
+                   std::chrono::steady_clock::time_point::max()) -> bool {
+        auto notified = [&parker]() { return parker.notified; };
+
+        while (true) {
+            // Link before checking, lock free pushers read `_parked.size()`
+            // after bumping `_size`.
+            _parked.link(parker);
+            if (ready()) {
+                _parked.unlink(parker);
+                return true;
+            }
+
+            if (auto *stats = detail::current_stats(); stats != nullptr) {
+                detail::bump(stats->parks);
+            }
+
+            if (deadline == std::chrono::steady_clock::time_point::max()) {
+                parker.cond.wait(guard, notified);
+            } else if (!parker.cond.wait_until(guard, deadline, notified)) {
+                _parked.unlink(parker);
+                return ready();
+            }
+        }
+    }
+
+    /**
+     * @brief Park until queue is not empty or pred (non concurrent queue
+     * only), `_lock` should be held.
+     *
+     * @param guard Lock guard of `_lock`.
+     * @param parker Parking slot of calling thread.
+     * @param pred User pred function.
+     * @return true Queue is not empty.
+     * @return false User pred is satisfied.
+     */
+    template <typename F>
+    auto _wait_ready(std::unique_lock<std::mutex> &guard,
+                     detail::Parker &parker, F &&pred) -> bool {
+        auto is_user_pred = false;
+        _park(guard, parker, [this, &is_user_pred, &pred]() {
+            if (pred()) {
+                is_user_pred = true;
+                return true;
+            }
+
+            return !this->empty();
+        });
+
+        // The wakeup may be meant for a task, hand it over.
+        if (is_user_pred && !empty()) {
+            _parked.unpark(1);
+        }
+
+        return !is_user_pred;
+    }
+
     /**
      * @brief Wrapper of pop, which is used to update empty flag.
      *
      * @return TaskType Task object.
      */
     auto _pop_impl() -> TaskType;
+
+    /**
+     * @brief Pop up to the fair share of tasks, `_lock` should be held and
+     * queue should not be empty.
+     *
+     * @param out Output buffer.
+     * @param max Max tasks to pop.
+     * @return std::size_t Tasks popped.
+     */
+    auto _pop_bulk_impl(std::vector<TaskType> &out, std::size_t max)
+        -> std::size_t;
+
+    /**
+     * @brief Try to pop up to the fair share of tasks without waiting
+     * (concurrent queue only).
+     *
+     * @param out Output buffer.
+     * @param max Max tasks to pop.
+     * @return std::size_t Tasks popped.
+     */
+    auto _try_pop_bulk(std::vector<TaskType> &out, std::size_t max)
+        -> std::size_t;
+
+    /**
+     * @brief Get max tasks one worker may take in a batch.
+     *
+     * @param avail Tasks available.
+     * @param max Batch size.
+     * @return std::size_t Batch bound, at least 1.
+     */
+    [[nodiscard]] auto _fair_share(std::size_t avail, std::size_t max) const
+        -> std::size_t;
+
+    /**
+     * @brief Try to pop one task without waiting (concurrent queue only).
+     *
+     * @return std::optional<TaskType> Task object.
+     */
+    auto _try_pop() -> std::optional<TaskType>;
+
+    /**
+     * @brief Try to pop one task in STEAL policy, from local deque, injection
+     * queue and other workers in order.
+     *
+     * @return std::optional<TaskType> Task object.
+     */
+    auto _try_pop_steal() -> std::optional<TaskType>;
+
+    /**
+     * @brief Push to a full concurrent queue, retrying until a slot is free.
+     * An attached worker runs a queued task inline before each retry, other
+     * threads yield.
+     *
+     * @param task Task object, untouched by failed pushes.
+     */
+    auto _push_full(TaskType &&task) -> void;
+
+    /**
+     * @brief Run a task on calling thread, applying the miss policy and the
+     * error handler like a worker.
+     *
+     * @param task Task object.
+     */
+    auto _run_inline(TaskType &task) -> void;
+
+    /**
+     * @brief Add a task in STEAL policy, to local deque if calling thread is
+     * attached, or to the injection queue.
+     *
+     * @param task Task object.
+     */
+    auto _push_steal(TaskType &&task) -> void;
+
+    /**
+     * @brief Wake up parked threads after a push without `_lock`.
+     *
+     * @param cnt Max threads to wake up.
+     */
+    auto _wakeup_sleepers(std::size_t cnt = 1) -> void;
+
+    /**
+     * @brief Get local deque slot of calling thread.
+     *
+     * @return detail::WorkerSlot* Slot, nullptr if thread is not attached.
+     */
+    [[nodiscard]] auto _local_slot() const -> detail::WorkerSlot *;
+
+    /**
+     * @brief Pop one task from concurrent queue (wait until queue is ready,
+     * pred or deadline).
+     *
+     * @param pred User pred function.
+     * @param parker Parking slot of calling thread.
+     * @param deadline Wait deadline.
+     * @return std::optional<TaskType> Task object.
+     */
+    template <typename F>
+    auto _pop_wait(F &&pred, detail::Parker &parker,
+                   std::chrono::steady_clock::time_point deadline =
+                       std::chrono::steady_clock::time_point::max())
+        -> std::optional<TaskType> {
+        while (!pred()) {
+            auto task = _try_pop();
+            if (task.has_value()) {
+                return task;
+            }
+
+            auto guard = std::unique_lock(_lock);
+            _park(
+                guard, parker,
+                [this, &pred]() { return pred() || !this->empty(); },
+                deadline);
+        }
+
+        // The wakeup may be meant for a task, hand it over.
+        if (!empty()) {
+            _wakeup_sleepers();
+        }
+
+        return {};
+    }
 };
 
 } // namespace nexus::exec
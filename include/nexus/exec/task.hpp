@@ -1,13 +1,16 @@
 #pragma once
 
 #include "nexus/common.hpp"
+#include "nexus/private/exec/alloc.hpp"
 #include "nexus/private/exec/task.hpp"
 
 #include <any>
+#include <chrono>
 #include <compare>
 #include <cstdint>
-#include <functional>
 #include <future>
+#include <memory>
+#include <optional>
 #include <type_traits>
 #include <utility>
 
@@ -27,17 +30,37 @@ template <typename R = std::any> class Task {
     using Result = std::decay_t<R>;
 
     /**
-     * @brief Task entry type.
+     * @brief Task entry type, callables up to `NEXUS_EXEC_TASK_INLINE_SIZE`
+     * bytes are stored inline.
      *
      */
-    using DynFunction = std::function<void(std::promise<Result> &)>;
+    using DynFunction = detail::TaskFunction<void(std::promise<Result> *)>;
 
     constexpr static std::int8_t DEFAULT_PRIO = 0;
 
+    /**
+     * @brief Deadline of tasks without one, never missed.
+     *
+     */
+    constexpr static auto NO_DEADLINE =
+        std::chrono::steady_clock::time_point::max();
+
   private:
-    DynFunction          _func;
-    std::promise<Result> _res;
-    std::int8_t          _prio{DEFAULT_PRIO};
+    DynFunction                         _func;
+    std::optional<std::promise<Result>> _res;
+    std::int8_t                         _prio{DEFAULT_PRIO};
+
+    /**
+     * @brief Time the task entered a queue, for wait time metrics.
+     *
+     */
+    std::chrono::steady_clock::time_point _enqueued;
+
+    /**
+     * @brief Absolute deadline, ordering key of EDF queues.
+     *
+     */
+    std::chrono::steady_clock::time_point _deadline{NO_DEADLINE};
 
   public:
     /**
@@ -53,7 +76,25 @@ template <typename R = std::any> class Task {
     template <typename F, typename... Args>
     explicit Task(F &&func, Args &&...args)
         : _func(_wrap_entry<F, Args...>(std::forward<F>(func),
-                                        std::forward<Args>(args)...)) {}
+                                        std::forward<Args>(args)...)),
+          _res(std::in_place, std::allocator_arg,
+               detail::PoolAllocator<Result>()) {}
+
+    /**
+     * @brief Construct a detached Task, which has no future, error of the
+     * function is thrown by `operator()`.
+     *
+     * @tparam F Task function type.
+     * @tparam Args Task arguments type.
+     * @param func Function.
+     * @param args Arguments.
+     *
+     * @note All reference type will be decayed.
+     */
+    template <typename F, typename... Args>
+    explicit Task(detail::TaskDetach /*tag*/, F &&func, Args &&...args)
+        : _func(_wrap_detached<F, Args...>(std::forward<F>(func),
+                                           std::forward<Args>(args)...)) {}
 
     ~Task() = default;
 
@@ -78,15 +119,32 @@ template <typename R = std::any> class Task {
     NEXUS_INLINE auto operator()() -> void {
         // Pass promise here to avoid invalid `this` pointer caused by
         // `std::move`.
-        _func(_res);
+        _func(_res.has_value() ? &_res.value() : nullptr);
     }
 
     /**
      * @brief Get task future.
      *
      * @return std::future<Result> Task result future.
+     *
+     * @throw std::future_error Task is detached.
      */
-    NEXUS_INLINE auto get_future() { return _res.get_future(); }
+    NEXUS_INLINE auto get_future() {
+        if (!_res.has_value()) {
+            throw std::future_error(std::future_errc::no_state);
+        }
+        return _res->get_future();
+    }
+
+    /**
+     * @brief Check if task is detached (has no future).
+     *
+     * @return true Task is detached.
+     * @return false Task has a future.
+     */
+    [[nodiscard]] NEXUS_INLINE auto detached() const -> bool {
+        return !_res.has_value();
+    }
 
     /**
      * @brief Get task priority.
@@ -102,6 +160,49 @@ template <typename R = std::any> class Task {
      */
     NEXUS_INLINE constexpr auto prio(int8_t prio) -> void { _prio = prio; }
 
+    /**
+     * @brief Get time the task entered a queue.
+     *
+     * @return std::chrono::steady_clock::time_point Enqueue time, epoch if
+     * task is not queued yet.
+     */
+    [[nodiscard]] NEXUS_INLINE auto enqueued() const
+        -> std::chrono::steady_clock::time_point {
+        return _enqueued;
+    }
+
+    /**
+     * @brief Set time the task entered a queue.
+     *
+     * @param time Enqueue time.
+     */
+    NEXUS_INLINE auto enqueued(std::chrono::steady_clock::time_point time)
+        -> void {
+        _enqueued = time;
+    }
+
+    /**
+     * @brief Get task deadline.
+     *
+     * @return std::chrono::steady_clock::time_point Deadline, `NO_DEADLINE`
+     * if not set.
+     */
+    [[nodiscard]] NEXUS_INLINE auto deadline() const
+        -> std::chrono::steady_clock::time_point {
+        return _deadline;
+    }
+
+    /**
+     * @brief Set task deadline, a worker taking the task after it applies
+     * the miss policy of the queue.
+     *
+     * @param time Absolute deadline.
+     */
+    NEXUS_INLINE auto deadline(std::chrono::steady_clock::time_point time)
+        -> void {
+        _deadline = time;
+    }
+
   private:
     /**
      * @brief Wrap function and arguments into entry function, which has
@@ -121,6 +222,28 @@ template <typename R = std::any> class Task {
         return typename Helper::Binder(std::forward<F>(func),
                                        std::forward<Args>(args)...);
     }
+
+    /**
+     * @brief Wrap function and arguments into entry function of detached
+     * task, result of the function is dropped.
+     *
+     * @tparam F Function type.
+     * @tparam Args Arguments type.
+     * @param func Function.
+     * @param args Arguments.
+     *
+     * @note The binder is typed with the real result of the function, so any
+     * callable is accepted, binder drops the value when it has no promise.
+     */
+    template <typename F, typename... Args>
+    NEXUS_INLINE constexpr auto _wrap_detached(F &&func, Args &&...args)
+        -> decltype(auto) {
+        using Helper =
+            detail::TaskHelper<F, detail::TaskResult<F, Args...>, Args...>;
+        return [binder = typename Helper::Binder(std::forward<F>(func),
+                                                 std::forward<Args>(args)...)](
+                   std::promise<Result> * /*res*/) mutable { binder(nullptr); };
+    }
 };
 
 } // namespace nexus::exec
@@ -1,5 +1,14 @@
 #pragma once
 
-#include "nexus/exec/thread/builder.hpp" // IWYU pragma: export
-#include "nexus/exec/thread/pool.hpp"    // IWYU pragma: export
-#include "nexus/exec/thread/worker.hpp"  // IWYU pragma: export
+#include "nexus/exec/thread/builder.hpp"  // IWYU pragma: export
+#include "nexus/exec/thread/cancel.hpp"   // IWYU pragma: export
+#include "nexus/exec/thread/coro.hpp"     // IWYU pragma: export
+#include "nexus/exec/thread/future.hpp"   // IWYU pragma: export
+#include "nexus/exec/thread/graph.hpp"    // IWYU pragma: export
+#include "nexus/exec/thread/group.hpp"    // IWYU pragma: export
+#include "nexus/exec/thread/metrics.hpp"  // IWYU pragma: export
+#include "nexus/exec/thread/numa.hpp"     // IWYU pragma: export
+#include "nexus/exec/thread/parallel.hpp" // IWYU pragma: export
+#include "nexus/exec/thread/pool.hpp"     // IWYU pragma: export
+#include "nexus/exec/thread/timer.hpp"    // IWYU pragma: export
+#include "nexus/exec/thread/worker.hpp"   // IWYU pragma: export
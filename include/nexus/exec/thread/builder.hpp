@@ -40,4 +40,12 @@ NEXUS_EXPORT auto io_bound() -> ThreadPool::Builder;
  */
 NEXUS_EXPORT auto time_bound() -> ThreadPool::Builder;
 
+/**
+ * @brief Get NUMA aware thread pool builder, one worker per cpu pinned to it
+ * and one queue per node, topology is read from sysfs.
+ *
+ * @return ThreadPool::Builder Thread pool builder.
+ */
+NEXUS_EXPORT auto numa() -> ThreadPool::Builder;
+
 } // namespace nexus::exec::thread_builder
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "nexus/common.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <stop_token>
+#include <type_traits>
+#include <utility>
+
+namespace nexus::exec {
+
+namespace detail {
+
+/**
+ * @brief Shared state of a cancellable task. The task stays in the queue
+ * when cancelled (tombstone), the worker taking it skips the call.
+ *
+ */
+class CancelState {
+  private:
+    enum Status : std::uint8_t {
+        QUEUED,
+        RUNNING,
+        CANCELLED,
+    };
+
+    std::atomic<std::uint8_t> _status{QUEUED};
+    std::stop_source          _source;
+
+  public:
+    /**
+     * @brief Mark the task running, called by the worker.
+     *
+     * @return true Task should run.
+     * @return false Task is cancelled.
+     */
+    NEXUS_INLINE auto start() -> bool {
+        auto expected = std::uint8_t(QUEUED);
+        return _status.compare_exchange_strong(expected, RUNNING);
+    }
+
+    /**
+     * @brief Cancel the task, or request a running task to stop.
+     *
+     * @return true Task is cancelled before it started.
+     * @return false Task already started, stop is requested.
+     */
+    NEXUS_INLINE auto cancel() -> bool {
+        auto expected = std::uint8_t(QUEUED);
+        if (_status.compare_exchange_strong(expected, CANCELLED) ||
+            expected == CANCELLED) {
+            return true;
+        }
+
+        _source.request_stop();
+        return false;
+    }
+
+    [[nodiscard]] NEXUS_INLINE auto token() const -> std::stop_token {
+        return _source.get_token();
+    }
+};
+
+/**
+ * @brief Result type of a cancellable task, the stop token is passed as first
+ * argument if the function accepts it.
+ *
+ * @tparam F Function type.
+ * @tparam Args Arguments type.
+ */
+template <typename F, typename... Args>
+using CancelResult = std::decay_t<typename std::conditional_t<
+    std::is_invocable_v<std::decay_t<F> &, std::stop_token,
+                        std::decay_t<Args>...>,
+    std::invoke_result<std::decay_t<F> &, std::stop_token,
+                       std::decay_t<Args>...>,
+    std::invoke_result<std::decay_t<F> &, std::decay_t<Args>...>>::type>;
+
+} // namespace detail
+
+/**
+ * @brief Handle to cancel a submitted task.
+ *
+ */
+class CancelHandle {
+  private:
+    std::shared_ptr<detail::CancelState> _state;
+
+  public:
+    CancelHandle() = default;
+    explicit CancelHandle(std::shared_ptr<detail::CancelState> state)
+        : _state(std::move(state)) {}
+
+    /**
+     * @brief Check if the handle refers to a task.
+     *
+     */
+    [[nodiscard]] NEXUS_INLINE auto valid() const -> bool {
+        return _state != nullptr;
+    }
+
+    /**
+     * @brief Cancel the task in O(1). A queued task is skipped when a worker
+     * takes it and its future throws `broken_promise`, a running task sees
+     * a stop request on its token.
+     *
+     * @return true Task is cancelled before it started.
+     * @return false Task already started (or finished), stop is requested.
+     */
+    NEXUS_INLINE auto cancel() -> bool { return _state->cancel(); }
+
+    /**
+     * @brief Get stop token of the task.
+     *
+     * @return std::stop_token Stop token, stop is requested once `cancel` is
+     * called on a started task.
+     */
+    [[nodiscard]] NEXUS_INLINE auto token() const -> std::stop_token {
+        return _state->token();
+    }
+};
+
+/**
+ * @brief Result of `ThreadPool::submit_cancellable`.
+ *
+ * @tparam R Result type.
+ */
+template <typename R> struct Cancellable {
+    std::future<R> future; /**< Task future. */
+    CancelHandle   handle; /**< Cancel handle. */
+};
+
+} // namespace nexus::exec
@@ -0,0 +1,322 @@
+#pragma once
+
+#include "nexus/common.hpp"
+#include "nexus/exec/thread/future.hpp"
+#include "nexus/exec/thread/pool.hpp"
+
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace nexus::exec {
+
+template <typename T = void> class CoTask;
+
+namespace detail {
+
+/**
+ * @brief Promise part shared by all `CoTask`, holds the awaiting coroutine
+ * and the error.
+ *
+ */
+class CoPromiseBase {
+  private:
+    std::coroutine_handle<> _cont{std::noop_coroutine()};
+    std::coroutine_handle<> _root;
+    std::exception_ptr      _error;
+
+  public:
+    /**
+     * @brief Resume the awaiting coroutine on the thread finishing the task,
+     * by symmetric transfer so long chains do not grow the stack.
+     *
+     */
+    struct FinalAwaiter {
+        [[nodiscard]] NEXUS_INLINE static auto await_ready() noexcept
+            -> bool {
+            return false;
+        }
+
+        template <typename P>
+        NEXUS_INLINE auto await_suspend(std::coroutine_handle<P> handle)
+            const noexcept -> std::coroutine_handle<> {
+            return handle.promise()._cont;
+        }
+
+        NEXUS_INLINE static auto await_resume() noexcept -> void {}
+    };
+
+    [[nodiscard]] NEXUS_INLINE static auto initial_suspend() noexcept
+        -> std::suspend_always {
+        return {};
+    }
+
+    [[nodiscard]] NEXUS_INLINE static auto final_suspend() noexcept
+        -> FinalAwaiter {
+        return {};
+    }
+
+    NEXUS_INLINE auto unhandled_exception() noexcept -> void {
+        _error = std::current_exception();
+    }
+
+    /**
+     * @brief Set the coroutine to resume when the task finishes.
+     *
+     * @param cont Awaiting coroutine.
+     * @param root Outermost coroutine of the await chain.
+     */
+    NEXUS_INLINE auto set_continuation(std::coroutine_handle<> cont,
+                                       std::coroutine_handle<> root) noexcept
+        -> void {
+        _cont = cont;
+        _root = root;
+    }
+
+    /**
+     * @brief Get the outermost coroutine of the await chain, destroying it
+     * destroys this one too.
+     *
+     * @return std::coroutine_handle<> Root coroutine.
+     */
+    [[nodiscard]] NEXUS_INLINE auto root() const noexcept
+        -> std::coroutine_handle<> {
+        return _root;
+    }
+
+  protected:
+    NEXUS_INLINE auto _rethrow() const -> void {
+        if (_error != nullptr) {
+            std::rethrow_exception(_error);
+        }
+    }
+};
+
+/**
+ * @brief Promise part holding the result.
+ *
+ * @tparam T Result type.
+ */
+template <typename T> class CoPromise : public CoPromiseBase {
+  private:
+    std::optional<T> _value;
+
+  public:
+    template <typename U = T>
+        requires std::is_convertible_v<U &&, T>
+    auto return_value(U &&value) -> void {
+        _value.emplace(std::forward<U>(value));
+    }
+
+    /**
+     * @brief Move the result out, the task should be done.
+     *
+     * @return T Result.
+     *
+     * @throw Error of the task.
+     */
+    auto result() -> T {
+        _rethrow();
+        return std::move(_value.value());
+    }
+};
+
+template <> class CoPromise<void> : public CoPromiseBase {
+  public:
+    NEXUS_INLINE static auto return_void() noexcept -> void {}
+
+    NEXUS_INLINE auto result() const -> void { _rethrow(); }
+};
+
+/**
+ * @brief Fire and forget coroutine, it starts at once and frees its frame
+ * when done.
+ *
+ */
+struct CoDetached {
+    struct promise_type {
+        NEXUS_INLINE static auto get_return_object() noexcept -> CoDetached {
+            return {};
+        }
+
+        NEXUS_INLINE static auto initial_suspend() noexcept
+            -> std::suspend_never {
+            return {};
+        }
+
+        NEXUS_INLINE static auto final_suspend() noexcept
+            -> std::suspend_never {
+            return {};
+        }
+
+        NEXUS_INLINE static auto return_void() noexcept -> void {}
+
+        /**
+         * @brief The detached coroutine is the root of its await chain.
+         *
+         */
+        NEXUS_INLINE auto root() noexcept -> std::coroutine_handle<> {
+            return std::coroutine_handle<promise_type>::from_promise(*this);
+        }
+
+        [[noreturn]] NEXUS_INLINE static auto unhandled_exception() noexcept
+            -> void {
+            std::terminate();
+        }
+    };
+};
+
+} // namespace detail
+
+/**
+ * @brief Lazy coroutine task, its body starts when awaited and the awaiting
+ * coroutine resumes on the thread finishing it, no thread blocks in between.
+ *
+ * @tparam T Result type.
+ *
+ * @note Use `co_await pool.schedule()` in the body to move onto the pool, and
+ * `co_spawn` to start a task from outside a coroutine.
+ */
+template <typename T> class CoTask {
+  public:
+    class promise_type : public detail::CoPromise<T> {
+      public:
+        auto get_return_object() noexcept -> CoTask {
+            return CoTask(
+                std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+    };
+
+    using Handle = std::coroutine_handle<promise_type>;
+
+    /**
+     * @brief Awaiter starting the task.
+     *
+     */
+    class Awaiter {
+      private:
+        Handle _handle;
+
+      public:
+        explicit Awaiter(Handle handle) : _handle(handle) {}
+
+        [[nodiscard]] NEXUS_INLINE static auto await_ready() noexcept
+            -> bool {
+            return false;
+        }
+
+        template <typename P>
+        NEXUS_INLINE auto await_suspend(std::coroutine_handle<P> cont) noexcept
+            -> std::coroutine_handle<> {
+            // Chains under coroutines of unknown owner have no root.
+            auto root = std::coroutine_handle<>();
+            if constexpr (requires { cont.promise().root(); }) {
+                root = cont.promise().root();
+            }
+            _handle.promise().set_continuation(cont, root);
+            return _handle;
+        }
+
+        NEXUS_INLINE auto await_resume() -> T {
+            return _handle.promise().result();
+        }
+    };
+
+  private:
+    Handle _handle;
+
+  public:
+    CoTask() = default;
+    explicit CoTask(Handle handle) : _handle(handle) {}
+
+    ~CoTask() {
+        if (_handle) {
+            _handle.destroy();
+        }
+    }
+
+    CoTask(const CoTask &other) = delete;
+    auto operator=(const CoTask &other) -> CoTask & = delete;
+
+    CoTask(CoTask &&other) noexcept
+        : _handle(std::exchange(other._handle, nullptr)) {}
+
+    auto operator=(CoTask &&other) noexcept -> CoTask & {
+        if (this != &other) {
+            if (_handle) {
+                _handle.destroy();
+            }
+            _handle = std::exchange(other._handle, nullptr);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Check if the task has a coroutine.
+     *
+     */
+    [[nodiscard]] NEXUS_INLINE auto valid() const -> bool {
+        return static_cast<bool>(_handle);
+    }
+
+    /**
+     * @brief Start the task and suspend until it finishes, a task is awaited
+     * once.
+     *
+     * @return Awaiter Awaiter, resumes with the result or throws the error.
+     */
+    NEXUS_INLINE auto operator co_await() && noexcept -> Awaiter {
+        return Awaiter(_handle);
+    }
+};
+
+namespace detail {
+
+/**
+ * @brief Run a task on calling worker and set a future state from it.
+ *
+ */
+template <typename T>
+auto co_run(CoTask<T> task, FuturePromise<T> res) -> CoDetached {
+    try {
+        if constexpr (std::is_void_v<T>) {
+            co_await std::move(task);
+            res.fulfill([]() {});
+        } else {
+            auto value = co_await std::move(task);
+            res.fulfill([&value]() -> T { return std::move(value); });
+        }
+    } catch (...) {
+        res.set_error(std::current_exception());
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Start a task on the pool.
+ *
+ * @tparam T Result type.
+ * @param pool Thread pool, should outlive the task.
+ * @param task Task.
+ * @return Future<T> Future of the task, continuations are posted to `pool`,
+ * holds `std::future_errc::broken_promise` if a pool drops the task before it
+ * starts or at a later `schedule()` hop.
+ */
+template <typename T>
+auto co_spawn(ThreadPool &pool, CoTask<T> task) -> Future<T> {
+    auto out = std::make_shared<detail::FutureState<T>>(&pool);
+
+    // The first hop owns the task, a pool dropping it breaks the future.
+    pool.post([task = std::move(task),
+               res = detail::FuturePromise<T>(out)]() mutable {
+        detail::co_run(std::move(task), std::move(res));
+    });
+
+    return Future<T>(std::move(out));
+}
+
+} // namespace nexus::exec
@@ -0,0 +1,591 @@
+#pragma once
+
+#include "nexus/common.hpp"
+#include "nexus/exec/thread/pool.hpp"
+#include "nexus/private/exec/task.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace nexus::exec {
+
+template <typename T> class Future;
+
+namespace detail {
+
+/**
+ * @brief Stored value type of a future, `void` is stored as monostate.
+ *
+ * @tparam T Value type.
+ */
+template <typename T>
+using FutureValue = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+/**
+ * @brief Shared state of a `Future`, holds the value or error and at most one
+ * continuation.
+ *
+ * @tparam T Value type.
+ */
+template <typename T> class FutureState {
+  private:
+    std::mutex                    _lock;
+    std::condition_variable       _cond;
+    std::optional<FutureValue<T>> _value;
+    std::exception_ptr            _error;
+    bool                          _ready{false};
+    TaskFunction<void()>          _cont;
+    ThreadPool                   *_pool;
+
+  public:
+    explicit FutureState(ThreadPool *pool) : _pool(pool) {}
+
+    /**
+     * @brief Get the pool continuations are posted to.
+     *
+     * @return ThreadPool* Thread pool.
+     */
+    [[nodiscard]] NEXUS_INLINE auto pool() const -> ThreadPool * {
+        return _pool;
+    }
+
+    /**
+     * @brief Set value and run the continuation on calling thread.
+     *
+     * @param value Value.
+     */
+    auto set_value(FutureValue<T> &&value) -> void {
+        auto guard = std::unique_lock(_lock);
+        _value.emplace(std::move(value));
+        _complete(guard);
+    }
+
+    /**
+     * @brief Set error and run the continuation on calling thread.
+     *
+     * @param err Error.
+     */
+    auto set_error(std::exception_ptr err) -> void {
+        auto guard = std::unique_lock(_lock);
+        _error = std::move(err);
+        _complete(guard);
+    }
+
+    /**
+     * @brief Set `std::future_errc::broken_promise` if the state is not set
+     * yet, its producer is dropped.
+     *
+     */
+    auto abandon() -> void {
+        auto guard = std::unique_lock(_lock);
+        if (_ready) {
+            return;
+        }
+
+        _error = std::make_exception_ptr(
+            std::future_error(std::future_errc::broken_promise));
+        _complete(guard);
+    }
+
+    /**
+     * @brief Set the continuation, it runs at once if the state is ready.
+     *
+     * @param cont Continuation.
+     */
+    auto on_ready(TaskFunction<void()> &&cont) -> void {
+        auto guard = std::unique_lock(_lock);
+        if (!_ready) {
+            _cont = std::move(cont);
+            return;
+        }
+
+        guard.unlock();
+        cont();
+    }
+
+    /**
+     * @brief Check if the state is ready.
+     *
+     */
+    [[nodiscard]] auto ready() -> bool {
+        auto guard = std::lock_guard(_lock);
+        return _ready;
+    }
+
+    /**
+     * @brief Block until the state is ready.
+     *
+     */
+    auto wait() -> void {
+        auto guard = std::unique_lock(_lock);
+        _cond.wait(guard, [this]() { return _ready; });
+    }
+
+    /**
+     * @brief Get the error, the state should be ready.
+     *
+     * @return std::exception_ptr Error, nullptr if a value is set.
+     */
+    [[nodiscard]] NEXUS_INLINE auto error() const -> std::exception_ptr {
+        return _error;
+    }
+
+    /**
+     * @brief Move the value out, the state should be ready.
+     *
+     * @return FutureValue<T> Value.
+     *
+     * @throw Error of the state.
+     */
+    auto take() -> FutureValue<T> {
+        if (_error != nullptr) {
+            std::rethrow_exception(_error);
+        }
+        return std::move(_value.value());
+    }
+
+  private:
+    auto _complete(std::unique_lock<std::mutex> &guard) -> void {
+        _ready = true;
+        auto cont = std::move(_cont);
+        guard.unlock();
+
+        _cond.notify_all();
+        if (cont) {
+            cont();
+        }
+    }
+};
+
+/**
+ * @brief Set state from the result of a function, errors are stored.
+ *
+ * @tparam T Value type.
+ * @tparam F Function type.
+ * @param state Future state.
+ * @param func Function.
+ */
+template <typename T, typename F>
+auto fulfill(FutureState<T> &state, F &&func) -> void {
+    try {
+        if constexpr (std::is_void_v<T>) {
+            std::forward<F>(func)();
+            state.set_value({});
+        } else {
+            state.set_value(std::forward<F>(func)());
+        }
+    } catch (...) {
+        state.set_error(std::current_exception());
+    }
+}
+
+/**
+ * @brief Producer of a future state, owned by the task setting it. Dropping
+ * it before the state is set, e.g. a task destroyed in a released queue,
+ * breaks the state like `std::promise`.
+ *
+ * @tparam T Value type.
+ */
+template <typename T> class FuturePromise {
+  private:
+    std::shared_ptr<FutureState<T>> _state;
+
+  public:
+    explicit FuturePromise(std::shared_ptr<FutureState<T>> state)
+        : _state(std::move(state)) {}
+
+    ~FuturePromise() {
+        if (_state != nullptr) {
+            _state->abandon();
+        }
+    }
+
+    FuturePromise(const FuturePromise &other) = delete;
+    auto operator=(const FuturePromise &other) -> FuturePromise & = delete;
+
+    FuturePromise(FuturePromise &&other) noexcept = default;
+    auto operator=(FuturePromise &&other) noexcept
+        -> FuturePromise & = delete;
+
+    /**
+     * @brief Set the state from the result of a function, see `fulfill`.
+     *
+     * @tparam F Function type.
+     * @param func Function.
+     */
+    template <typename F> auto fulfill(F &&func) -> void {
+        auto state = std::move(_state);
+        detail::fulfill(*state, std::forward<F>(func));
+    }
+
+    /**
+     * @brief Set the state to an error.
+     *
+     * @param err Error.
+     */
+    auto set_error(std::exception_ptr err) -> void {
+        auto state = std::move(_state);
+        state->set_error(std::move(err));
+    }
+};
+
+/**
+ * @brief Result type of a continuation of `Future<T>`.
+ *
+ * @tparam T Antecedent value type.
+ * @tparam F Continuation type.
+ */
+template <typename T, typename F> struct ThenResult {
+    using Type = std::invoke_result_t<std::decay_t<F> &, T>;
+};
+
+template <typename F> struct ThenResult<void, F> {
+    using Type = std::invoke_result_t<std::decay_t<F> &>;
+};
+
+} // namespace detail
+
+/**
+ * @brief Result of `when_any`.
+ *
+ * @tparam T Value type.
+ */
+template <typename T> struct AnyResult {
+    std::size_t            index; /**< Index of the first ready future. */
+    detail::FutureValue<T> value; /**< Its value. */
+};
+
+/**
+ * @brief Future with continuations, a continuation is posted to the pool when
+ * the antecedent is ready, no thread blocks in between.
+ *
+ * @tparam T Value type.
+ *
+ * @note A future has one consumer, `get`, `then` and `when_*` invalidate it.
+ */
+template <typename T> class Future {
+  public:
+    using ValueType = T;
+    using StatePtr = std::shared_ptr<detail::FutureState<T>>;
+
+  private:
+    StatePtr _state;
+
+  public:
+    Future() = default;
+    explicit Future(StatePtr state) : _state(std::move(state)) {}
+
+    ~Future() = default;
+
+    Future(const Future &other) = delete;
+    auto operator=(const Future &other) -> Future & = delete;
+
+    Future(Future &&other) noexcept = default;
+    auto operator=(Future &&other) noexcept -> Future & = default;
+
+    /**
+     * @brief Check if the future has a state.
+     *
+     */
+    [[nodiscard]] NEXUS_INLINE auto valid() const -> bool {
+        return _state != nullptr;
+    }
+
+    /**
+     * @brief Check if the value or error is set.
+     *
+     */
+    [[nodiscard]] NEXUS_INLINE auto ready() const -> bool {
+        return _state->ready();
+    }
+
+    /**
+     * @brief Block until ready, not for use on workers.
+     *
+     */
+    NEXUS_INLINE auto wait() const -> void { _state->wait(); }
+
+    /**
+     * @brief Block until ready and get the value, not for use on workers.
+     *
+     * @return T Value.
+     *
+     * @throw Error of the future.
+     */
+    auto get() -> T {
+        auto state = std::move(_state);
+        state->wait();
+
+        if constexpr (std::is_void_v<T>) {
+            state->take();
+        } else {
+            return state->take();
+        }
+    }
+
+    /**
+     * @brief Post `func(value)` to the pool when this future is ready.
+     *
+     * @tparam F Continuation type, invocable with `T` (or nothing if `T` is
+     * void).
+     * @param func Continuation.
+     * @return Future<U> Future of the continuation, holds the error of this
+     * future if it fails, `func` is not called then and the error is passed
+     * on the completing thread without a post.
+     */
+    template <typename F>
+    auto then(F &&func) -> Future<typename detail::ThenResult<T, F>::Type> {
+        using U = typename detail::ThenResult<T, F>::Type;
+
+        auto in = std::move(_state);
+        auto out = std::make_shared<detail::FutureState<U>>(in->pool());
+
+        auto *state = in.get();
+        auto  cont = [in = std::move(in),
+                     out = detail::FuturePromise<U>(out),
+                     func = std::decay_t<F>(std::forward<F>(func))]() mutable {
+            // A broken antecedent may complete while its pool is released,
+            // never post from there.
+            if (auto err = in->error(); err != nullptr) {
+                out.set_error(std::move(err));
+                return;
+            }
+
+            auto *pool = in->pool();
+            pool->post([in = std::move(in), out = std::move(out),
+                        func = std::move(func)]() mutable {
+                out.fulfill([&]() -> U {
+                    if constexpr (std::is_void_v<T>) {
+                        in->take();
+                        return func();
+                    } else {
+                        return func(in->take());
+                    }
+                });
+            });
+        };
+        state->on_ready(std::move(cont));
+
+        return Future<U>(std::move(out));
+    }
+
+    template <typename... Ts>
+    friend auto when_all(Future<Ts>... futs)
+        -> Future<std::tuple<detail::FutureValue<Ts>...>>;
+
+    template <typename U>
+    friend auto when_all(std::vector<Future<U>> futs)
+        -> Future<std::vector<detail::FutureValue<U>>>;
+
+    template <typename U>
+    friend auto when_any(std::vector<Future<U>> futs) -> Future<AnyResult<U>>;
+
+  private:
+    NEXUS_INLINE auto _release() -> StatePtr { return std::move(_state); }
+};
+
+/**
+ * @brief Run a function on the pool.
+ *
+ * @tparam F Function type.
+ * @tparam Args Arguments type.
+ * @param pool Thread pool, continuations are posted to it too.
+ * @param func Function.
+ * @param args Arguments, decayed and moved into the task.
+ * @return Future<R> Future of the function, holds
+ * `std::future_errc::broken_promise` if the pool drops the task.
+ */
+template <typename F, typename... Args>
+auto async(ThreadPool &pool, F &&func, Args &&...args)
+    -> Future<std::invoke_result_t<std::decay_t<F> &, std::decay_t<Args>...>> {
+    using R = std::invoke_result_t<std::decay_t<F> &, std::decay_t<Args>...>;
+
+    auto out = std::make_shared<detail::FutureState<R>>(&pool);
+    pool.post(
+        [res = detail::FuturePromise<R>(out),
+         func = std::decay_t<F>(std::forward<F>(func)),
+         ... args = std::decay_t<Args>(std::forward<Args>(args))]() mutable {
+            res.fulfill([&]() -> R {
+                return std::invoke(func, std::move(args)...);
+            });
+        });
+
+    return Future<R>(std::move(out));
+}
+
+/**
+ * @brief Get a future ready when all futures are ready, it runs on the thread
+ * completing the last one.
+ *
+ * @tparam Ts Value types.
+ * @param futs Futures.
+ * @return Future<std::tuple<...>> Values in order, or the first error.
+ */
+template <typename... Ts>
+auto when_all(Future<Ts>... futs)
+    -> Future<std::tuple<detail::FutureValue<Ts>...>> {
+    static_assert(sizeof...(Ts) > 0, "when_all needs at least one future");
+
+    using Values = std::tuple<detail::FutureValue<Ts>...>;
+
+    struct Shared {
+        std::tuple<std::optional<detail::FutureValue<Ts>>...> values;
+        std::atomic_size_t remaining{sizeof...(Ts)};
+        std::atomic_bool   failed{false};
+        std::shared_ptr<detail::FutureState<Values>> out;
+    };
+
+    auto states = std::tuple(futs._release()...);
+    auto shared = std::make_shared<Shared>();
+    shared->out = std::make_shared<detail::FutureState<Values>>(
+        std::get<0>(states)->pool());
+    auto out = shared->out;
+
+    auto finish = [](Shared &all) {
+        if (all.remaining.fetch_sub(1, std::memory_order_acq_rel) != 1 ||
+            all.failed.load()) {
+            return;
+        }
+
+        all.out->set_value(std::apply(
+            [](auto &...values) { return Values(std::move(*values)...); },
+            all.values));
+    };
+
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        (std::get<I>(states)->on_ready(
+             [shared, finish, in = std::get<I>(states)]() {
+                 try {
+                     std::get<I>(shared->values).emplace(in->take());
+                 } catch (...) {
+                     if (!shared->failed.exchange(true)) {
+                         shared->out->set_error(std::current_exception());
+                     }
+                 }
+                 finish(*shared);
+             }),
+         ...);
+    }(std::index_sequence_for<Ts...>());
+
+    return Future<Values>(std::move(out));
+}
+
+/**
+ * @brief Get a future ready when all futures are ready.
+ *
+ * @tparam T Value type.
+ * @param futs Futures, not empty.
+ * @return Future<std::vector<T>> Values in order, or the first error.
+ *
+ * @throw std::invalid_argument `futs` is empty.
+ */
+template <typename T>
+auto when_all(std::vector<Future<T>> futs)
+    -> Future<std::vector<detail::FutureValue<T>>> {
+    using Values = std::vector<detail::FutureValue<T>>;
+
+    if (futs.empty()) {
+        throw std::invalid_argument("when_all needs at least one future");
+    }
+
+    struct Shared {
+        std::vector<std::optional<detail::FutureValue<T>>> values;
+        std::atomic_size_t                                 remaining;
+        std::atomic_bool                                   failed{false};
+        std::shared_ptr<detail::FutureState<Values>>       out;
+    };
+
+    auto shared = std::make_shared<Shared>();
+    shared->values.resize(futs.size());
+    shared->remaining.store(futs.size());
+    shared->out =
+        std::make_shared<detail::FutureState<Values>>(futs[0]._state->pool());
+    auto out = shared->out;
+
+    for (std::size_t i = 0; i < futs.size(); ++i) {
+        auto in = futs[i]._release();
+        auto *state = in.get();
+        state->on_ready([shared, i, in = std::move(in)]() {
+            try {
+                shared->values[i].emplace(in->take());
+            } catch (...) {
+                if (!shared->failed.exchange(true)) {
+                    shared->out->set_error(std::current_exception());
+                }
+            }
+
+            if (shared->remaining.fetch_sub(1, std::memory_order_acq_rel) !=
+                    1 ||
+                shared->failed.load()) {
+                return;
+            }
+
+            auto values = Values();
+            values.reserve(shared->values.size());
+            for (auto &value : shared->values) {
+                values.push_back(std::move(value.value()));
+            }
+            shared->out->set_value(std::move(values));
+        });
+    }
+
+    return Future<Values>(std::move(out));
+}
+
+/**
+ * @brief Get a future ready when the first future is ready.
+ *
+ * @tparam T Value type.
+ * @param futs Futures, not empty.
+ * @return Future<AnyResult<T>> Index and value of the first ready future, or
+ * its error.
+ *
+ * @throw std::invalid_argument `futs` is empty.
+ */
+template <typename T>
+auto when_any(std::vector<Future<T>> futs) -> Future<AnyResult<T>> {
+    if (futs.empty()) {
+        throw std::invalid_argument("when_any needs at least one future");
+    }
+
+    struct Shared {
+        std::atomic_bool                                     done{false};
+        std::shared_ptr<detail::FutureState<AnyResult<T>>> out;
+    };
+
+    auto shared = std::make_shared<Shared>();
+    shared->out = std::make_shared<detail::FutureState<AnyResult<T>>>(
+        futs[0]._state->pool());
+    auto out = shared->out;
+
+    for (std::size_t i = 0; i < futs.size(); ++i) {
+        auto in = futs[i]._release();
+        auto *state = in.get();
+        state->on_ready([shared, i, in = std::move(in)]() {
+            if (shared->done.exchange(true)) {
+                return;
+            }
+
+            detail::fulfill(*shared->out, [&]() {
+                return AnyResult<T>{.index = i, .value = in->take()};
+            });
+        });
+    }
+
+    return Future<AnyResult<T>>(std::move(out));
+}
+
+} // namespace nexus::exec
@@ -0,0 +1,259 @@
+#pragma once
+
+#include "nexus/common.hpp"
+#include "nexus/exec/thread/pool.hpp"
+#include "nexus/private/exec/task.hpp"
+
+#include <any>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <future>
+#include <initializer_list>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace nexus::exec {
+
+/**
+ * @brief Graph of tasks with dependencies, executed on a thread pool. A node
+ * is enqueued once all of its dependencies finish, no worker blocks on
+ * another task.
+ *
+ * @note The graph is built once and can be run many times, a run only resets
+ * counters and results. Nodes can only depend on nodes added before them, so
+ * the graph has no cycles.
+ */
+class NEXUS_EXPORT TaskGraph {
+  public:
+    /**
+     * @brief Node index, in adding order.
+     *
+     */
+    using NodeId = std::size_t;
+
+    /**
+     * @brief Results of dependencies of a node, in declared order.
+     *
+     */
+    class Inputs {
+      private:
+        const TaskGraph         *_graph;
+        std::span<const NodeId> _deps;
+
+      public:
+        Inputs(const TaskGraph *graph, std::span<const NodeId> deps)
+            : _graph(graph), _deps(deps) {}
+
+        /**
+         * @brief Get result of a dependency.
+         *
+         * @param idx Dependency index.
+         * @return const std::any& Result, empty if the node returns void.
+         */
+        [[nodiscard]] NEXUS_INLINE auto operator[](std::size_t idx) const
+            -> const std::any & {
+            return _graph->_results[_deps[idx]];
+        }
+
+        /**
+         * @brief Get typed result of a dependency.
+         *
+         * @tparam T Result type.
+         * @param idx Dependency index.
+         * @return const T& Result.
+         *
+         * @throw std::bad_any_cast Result is not T.
+         */
+        template <typename T>
+        [[nodiscard]] NEXUS_INLINE auto get(std::size_t idx) const
+            -> const T & {
+            return std::any_cast<const T &>((*this)[idx]);
+        }
+
+        /**
+         * @brief Get count of dependencies.
+         *
+         * @return std::size_t Dependency count.
+         */
+        [[nodiscard]] NEXUS_INLINE auto size() const -> std::size_t {
+            return _deps.size();
+        }
+    };
+
+    /**
+     * @brief Node entry type.
+     *
+     */
+    using NodeFunction = detail::TaskFunction<std::any(const Inputs &)>;
+
+  private:
+    /**
+     * @brief Node of the graph.
+     *
+     */
+    struct Node {
+        NodeFunction        func;
+        std::vector<NodeId> deps;
+        std::vector<NodeId> succs;
+
+        /**
+         * @brief Dependencies not finished yet in the current run.
+         *
+         */
+        std::atomic_size_t pending{0};
+
+        /**
+         * @brief A dependency failed or was skipped in the current run.
+         *
+         */
+        std::atomic_bool poisoned{false};
+    };
+
+    /**
+     * @brief Nodes are boxed, adding a node never moves the counters.
+     *
+     */
+    std::vector<std::unique_ptr<Node>> _nodes;
+    std::vector<NodeId>                _sources;
+    std::vector<std::any>              _results;
+
+    ThreadPool        *_pool{nullptr};
+    std::atomic_size_t _remaining{0};
+    std::atomic_bool   _failed{false};
+    std::exception_ptr _error;
+    std::promise<void> _done;
+    std::atomic_bool   _running{false};
+
+  public:
+    TaskGraph() = default;
+    ~TaskGraph() = default;
+
+    TaskGraph(const TaskGraph &other) = delete;
+    auto operator=(const TaskGraph &other) -> TaskGraph & = delete;
+
+    TaskGraph(TaskGraph &&other) = delete;
+    auto operator=(TaskGraph &&other) -> TaskGraph & = delete;
+
+    /**
+     * @brief Add a node.
+     *
+     * @tparam F Function type, invocable with `const Inputs &` or nothing.
+     * @param func Function, its result is passed to the nodes depending on
+     * it.
+     * @param deps Nodes to finish before this one.
+     * @return NodeId Node index.
+     *
+     * @throw std::out_of_range Dependency is not added yet.
+     * @throw std::logic_error Graph is running.
+     */
+    template <typename F>
+    auto add(F &&func, std::span<const NodeId> deps = {}) -> NodeId {
+        return _add(_wrap(std::forward<F>(func)), deps);
+    }
+
+    /**
+     * @brief Add a node.
+     *
+     * @tparam F Function type, invocable with `const Inputs &` or nothing.
+     * @param func Function.
+     * @param deps Nodes to finish before this one.
+     * @return NodeId Node index.
+     */
+    template <typename F>
+    NEXUS_INLINE auto add(F &&func, std::initializer_list<NodeId> deps)
+        -> NodeId {
+        return add(std::forward<F>(func),
+                   std::span<const NodeId>(deps.begin(), deps.size()));
+    }
+
+    /**
+     * @brief Run the graph on a thread pool.
+     *
+     * @param pool Thread pool, should outlive the run.
+     * @return std::future<void> Ready when all nodes finish, holds the first
+     * error thrown by a node. Nodes depending on a failed node, directly or
+     * not, are skipped, independent nodes still run.
+     *
+     * @throw std::logic_error Graph is already running.
+     */
+    auto run(ThreadPool &pool) -> std::future<void>;
+
+    /**
+     * @brief Get result of a node in the last finished run.
+     *
+     * @param node Node index.
+     * @return const std::any& Result, empty if the node returns void or is
+     * skipped.
+     */
+    [[nodiscard]] NEXUS_INLINE auto result(NodeId node) const
+        -> const std::any & {
+        return _results.at(node);
+    }
+
+    /**
+     * @brief Get count of nodes.
+     *
+     * @return std::size_t Node count.
+     */
+    [[nodiscard]] NEXUS_INLINE auto size() const -> std::size_t {
+        return _nodes.size();
+    }
+
+  private:
+    /**
+     * @brief Wrap function into node entry, void results become empty.
+     *
+     */
+    template <typename F> static auto _wrap(F &&func) -> NodeFunction {
+        using Callable = std::decay_t<F>;
+
+        return [func = Callable(std::forward<F>(func))](
+                   const Inputs &inputs) mutable -> std::any {
+            if constexpr (std::is_invocable_v<Callable &, const Inputs &>) {
+                using R = std::invoke_result_t<Callable &, const Inputs &>;
+                if constexpr (std::is_void_v<R>) {
+                    func(inputs);
+                    return {};
+                } else {
+                    return func(inputs);
+                }
+            } else {
+                using R = std::invoke_result_t<Callable &>;
+                if constexpr (std::is_void_v<R>) {
+                    func();
+                    return {};
+                } else {
+                    return func();
+                }
+            }
+        };
+    }
+
+    /**
+     * @brief Add a wrapped node.
+     *
+     */
+    auto _add(NodeFunction &&func, std::span<const NodeId> deps) -> NodeId;
+
+    /**
+     * @brief Run a node on calling worker, then its successors that become
+     * ready. One ready successor continues on this thread, others are
+     * posted.
+     *
+     * @param node Node index.
+     */
+    auto _execute(NodeId node) -> void;
+
+    /**
+     * @brief Post a node to the pool.
+     *
+     * @param node Node index.
+     */
+    auto _post(NodeId node) -> void;
+};
+
+} // namespace nexus::exec
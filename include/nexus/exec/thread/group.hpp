@@ -0,0 +1,152 @@
+#pragma once
+
+#include "nexus/common.hpp"
+#include "nexus/private/exec/help.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace nexus::exec {
+
+class ThreadPool;
+
+namespace detail {
+
+/**
+ * @brief Spawned task of a group. It runs once, either on the worker taking
+ * its queued task or on a thread waiting for the group.
+ *
+ */
+class GroupChild {
+  private:
+    std::atomic_bool _claimed{false};
+
+  public:
+    GroupChild() = default;
+    virtual ~GroupChild() = default;
+
+    GroupChild(const GroupChild &other) = delete;
+    auto operator=(const GroupChild &other) -> GroupChild & = delete;
+
+    GroupChild(GroupChild &&other) = delete;
+    auto operator=(GroupChild &&other) -> GroupChild & = delete;
+
+    /**
+     * @brief Claim the child before running it.
+     *
+     * @return true The caller should run the child.
+     * @return false The child is claimed by another thread.
+     */
+    NEXUS_INLINE auto claim() -> bool {
+        return !_claimed.exchange(true, std::memory_order_acq_rel);
+    }
+
+    virtual auto call() -> void = 0;
+};
+
+template <typename F> class GroupChildImpl final : public GroupChild {
+  private:
+    F _func;
+
+  public:
+    template <typename Fn>
+    explicit GroupChildImpl(Fn &&func) : _func(std::forward<Fn>(func)) {}
+
+    auto call() -> void override { std::invoke(_func); }
+};
+
+/**
+ * @brief Result type of a `fork_join` branch, `std::monostate` for void.
+ *
+ * @tparam F Function type.
+ */
+template <typename F>
+using ForkValue =
+    std::conditional_t<std::is_void_v<std::invoke_result_t<F &>>,
+                       std::monostate,
+                       std::decay_t<std::invoke_result_t<F &>>>;
+
+template <typename F> auto fork_call(F &func) -> ForkValue<F> {
+    if constexpr (std::is_void_v<std::invoke_result_t<F &>>) {
+        std::invoke(func);
+        return {};
+    } else {
+        return std::invoke(func);
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Group of tasks spawned on a thread pool and waited together.
+ *
+ * The waiting thread runs unstarted children of the group first (newest
+ * first), then other queued tasks of the pool, so recursive algorithms can
+ * wait in pool tasks without extra threads.
+ *
+ * @note Spawn from the owner, or from children of the group. The group
+ * should not outlive the pool.
+ */
+class NEXUS_EXPORT TaskGroup {
+  private:
+    ThreadPool        *_pool;
+    detail::HelpLatch  _latch;
+    std::atomic_bool   _failed{false};
+    std::exception_ptr _error;
+
+    std::mutex _lock;
+    std::vector<std::shared_ptr<detail::GroupChild>>
+        _children; /**< Spawned children, newest last. Some may be claimed
+                      by workers already. */
+
+  public:
+    explicit TaskGroup(ThreadPool &pool) : _pool(&pool) {}
+
+    /**
+     * @brief Wait for the children, errors are dropped.
+     *
+     */
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup &other) = delete;
+    auto operator=(const TaskGroup &other) -> TaskGroup & = delete;
+
+    TaskGroup(TaskGroup &&other) = delete;
+    auto operator=(TaskGroup &&other) -> TaskGroup & = delete;
+
+    /**
+     * @brief Spawn a child, posted to the pool.
+     *
+     * @tparam F Function type.
+     * @param func Function, called without arguments.
+     */
+    template <typename F> auto spawn(F &&func) -> void {
+        _spawn(std::make_shared<detail::GroupChildImpl<std::decay_t<F>>>(
+            std::forward<F>(func)));
+    }
+
+    /**
+     * @brief Wait for all children, helping meanwhile (see
+     * `detail::HelpLatch::wait`). The group can be reused after.
+     *
+     * @throw The first error of the children, children not started yet are
+     * skipped after an error.
+     */
+    auto wait() -> void;
+
+  private:
+    auto _spawn(std::shared_ptr<detail::GroupChild> child) -> void;
+    auto _take() -> std::shared_ptr<detail::GroupChild>;
+    auto _run(detail::GroupChild &child) -> void;
+    auto _wait() -> void;
+};
+
+} // namespace nexus::exec
@@ -0,0 +1,195 @@
+#pragma once
+
+#include "nexus/common.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace nexus::exec {
+
+namespace detail {
+
+class AtomicHistogram;
+
+} // namespace detail
+
+/**
+ * @brief Log bucketed histogram (HDR style), each power of two range is split
+ * into `SUB_BUCKETS` linear buckets, so a recorded value is reported within
+ * `1 / SUB_BUCKETS` of itself.
+ *
+ */
+class NEXUS_EXPORT Histogram {
+  public:
+    constexpr static std::size_t SUB_BITS = 4;
+    constexpr static std::size_t SUB_BUCKETS = std::size_t(1) << SUB_BITS;
+
+    /**
+     * @brief Bucket count, values below `SUB_BUCKETS` are exact, then
+     * `SUB_BUCKETS` buckets for each bit above `SUB_BITS`.
+     *
+     */
+    constexpr static std::size_t BUCKETS = (64 - SUB_BITS + 1) * SUB_BUCKETS;
+
+  private:
+    std::array<std::uint64_t, BUCKETS> _counts{};
+    std::uint64_t                      _count{0};
+    std::uint64_t                      _sum{0};
+    std::uint64_t                      _min{UINT64_MAX};
+    std::uint64_t                      _max{0};
+
+    friend class detail::AtomicHistogram;
+
+  public:
+    /**
+     * @brief Record a value.
+     *
+     * @param value Value.
+     * @param cnt Times to record the value.
+     */
+    auto record(std::uint64_t value, std::uint64_t cnt = 1) -> void;
+
+    /**
+     * @brief Add all values of another histogram.
+     *
+     * @param other Histogram to merge.
+     */
+    auto merge(const Histogram &other) -> void;
+
+    /**
+     * @brief Get value at a percentile, the highest value of its bucket.
+     *
+     * @param pct Percentile in `[0, 100]`.
+     * @return std::uint64_t Value, 0 if histogram is empty.
+     */
+    [[nodiscard]] auto percentile(double pct) const -> std::uint64_t;
+
+    /**
+     * @brief Get recorded count.
+     *
+     * @return std::uint64_t Recorded count.
+     */
+    [[nodiscard]] NEXUS_INLINE auto count() const -> std::uint64_t {
+        return _count;
+    }
+
+    /**
+     * @brief Get sum of recorded values.
+     *
+     * @return std::uint64_t Sum of values.
+     */
+    [[nodiscard]] NEXUS_INLINE auto sum() const -> std::uint64_t {
+        return _sum;
+    }
+
+    /**
+     * @brief Get min recorded value.
+     *
+     * @return std::uint64_t Min value, 0 if histogram is empty.
+     */
+    [[nodiscard]] NEXUS_INLINE auto min() const -> std::uint64_t {
+        return _count == 0 ? 0 : _min;
+    }
+
+    /**
+     * @brief Get max recorded value.
+     *
+     * @return std::uint64_t Max value.
+     */
+    [[nodiscard]] NEXUS_INLINE auto max() const -> std::uint64_t {
+        return _max;
+    }
+
+    /**
+     * @brief Get mean of recorded values.
+     *
+     * @return double Mean value, 0 if histogram is empty.
+     */
+    [[nodiscard]] NEXUS_INLINE auto mean() const -> double {
+        return _count == 0 ? 0.0
+                           : static_cast<double>(_sum) /
+                                 static_cast<double>(_count);
+    }
+
+    /**
+     * @brief Get bucket index of a value.
+     *
+     * @param value Value.
+     * @return std::size_t Bucket index.
+     */
+    [[nodiscard]] static auto bucket(std::uint64_t value) -> std::size_t;
+
+    /**
+     * @brief Get highest value of a bucket.
+     *
+     * @param idx Bucket index.
+     * @return std::uint64_t Highest value.
+     */
+    [[nodiscard]] static auto bucket_max(std::size_t idx) -> std::uint64_t;
+};
+
+/**
+ * @brief Counters of one worker.
+ *
+ */
+struct WorkerMetrics {
+    std::uint64_t executed{0}; /**< Tasks executed. */
+    std::uint64_t steals{0};   /**< Tasks taken from other workers or nodes. */
+    std::uint64_t parks{0};    /**< Times the worker went to sleep. */
+    std::uint64_t misses{0};   /**< Tasks taken after their deadline. */
+    std::uint64_t late{0};     /**< Tasks finished after their deadline. */
+};
+
+/**
+ * @brief Snapshot of thread pool metrics, durations are in nanoseconds.
+ *
+ */
+struct PoolMetrics {
+    Histogram wait; /**< Enqueue to start latency of tasks. */
+    Histogram run;  /**< Execution time of tasks. */
+
+    /**
+     * @brief Counters of workers not removed yet, running workers first.
+     *
+     */
+    std::vector<WorkerMetrics> workers;
+
+    /**
+     * @brief Counters of all workers, including removed ones.
+     *
+     */
+    std::uint64_t executed{0};
+    std::uint64_t steals{0};
+    std::uint64_t parks{0};
+
+    /**
+     * @brief Deadline misses of all workers, tasks taken after their
+     * deadline (dropped, handed over or run per `MissPolicy`) and tasks
+     * started in time but finished late.
+     *
+     */
+    std::uint64_t misses{0};
+    std::uint64_t late{0};
+
+    std::size_t depth{0};      /**< Tasks queued now. */
+    std::size_t peak_depth{0}; /**< Peak tasks queued in one queue. */
+
+    std::chrono::nanoseconds uptime{0}; /**< Time since pool creation. */
+
+    /**
+     * @brief Get average tasks executed per second since pool creation.
+     *
+     * @return double Throughput.
+     */
+    [[nodiscard]] NEXUS_INLINE auto throughput() const -> double {
+        return uptime.count() == 0
+                   ? 0.0
+                   : static_cast<double>(executed) * 1e9 /
+                         static_cast<double>(uptime.count());
+    }
+};
+
+} // namespace nexus::exec
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "nexus/common.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace nexus::exec {
+
+/**
+ * @brief NUMA node with its online cpus.
+ *
+ */
+struct NumaNode {
+    std::size_t              id;   /**< Node id in sysfs. */
+    std::vector<std::size_t> cpus; /**< Cpu ids of the node. */
+};
+
+/**
+ * @brief Default sysfs directory of NUMA nodes.
+ *
+ */
+constexpr std::string_view NUMA_SYSFS_ROOT = "/sys/devices/system/node";
+
+/**
+ * @brief Discover NUMA topology from sysfs, nodes without cpus are skipped.
+ *
+ * @param root Sysfs directory of NUMA nodes.
+ * @return std::vector<NumaNode> Nodes sorted by id, a single node with all
+ * cpus if topology is not available.
+ */
+NEXUS_EXPORT auto numa_nodes(const std::filesystem::path &root =
+                                 NUMA_SYSFS_ROOT) -> std::vector<NumaNode>;
+
+/**
+ * @brief Parse a sysfs cpu list, e.g. `0-3,8,10-11`.
+ *
+ * @param list Cpu list.
+ * @return std::vector<std::size_t> Cpu ids, empty if list is malformed.
+ */
+NEXUS_EXPORT auto parse_cpu_list(std::string_view list)
+    -> std::vector<std::size_t>;
+
+/**
+ * @brief Get cpu of calling thread.
+ *
+ * @return std::optional<std::size_t> Cpu id, empty if not supported.
+ */
+NEXUS_EXPORT auto current_cpu() -> std::optional<std::size_t>;
+
+} // namespace nexus::exec
@@ -0,0 +1,330 @@
+#pragma once
+
+#include "nexus/common.hpp"
+#include "nexus/exec/thread/pool.hpp"
+#include "nexus/private/exec/help.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+namespace nexus::exec {
+
+namespace detail {
+
+/**
+ * @brief Chunks per loop of the automatic grain, the serial path checks the
+ * pool once per chunk.
+ *
+ */
+constexpr std::size_t PARALLEL_AUTO_CHUNKS = 1024;
+
+/**
+ * @brief Shared state of one parallel loop over `[0, size)`. Pieces of the
+ * range run on workers and on the caller, one counter tracks them all.
+ *
+ */
+class ParallelLoop {
+  private:
+    ThreadPool        *_pool;
+    std::size_t        _grain;
+    HelpLatch          _latch{1}; /**< Unfinished pieces, the first one is run
+                                     by the caller. */
+    std::atomic_bool   _failed{false};
+    std::exception_ptr _error;
+
+  public:
+    ParallelLoop(ThreadPool &pool, std::size_t grain)
+        : _pool(&pool), _grain(grain) {}
+    ~ParallelLoop() = default;
+
+    ParallelLoop(const ParallelLoop &other) = delete;
+    auto operator=(const ParallelLoop &other) -> ParallelLoop & = delete;
+
+    ParallelLoop(ParallelLoop &&other) = delete;
+    auto operator=(ParallelLoop &&other) -> ParallelLoop & = delete;
+
+    /**
+     * @brief Run a piece on calling thread, a grain at a time. Whenever the
+     * pool is starving (see `ThreadPool::starving`), the upper half of what
+     * is left becomes a new piece (lazy binary splitting), so a busy pool
+     * gets no extra tasks.
+     *
+     * @tparam Body Loop body, with `local()`, `chunk(local, first, last)` and
+     * `merge(local)`.
+     * @param first First index.
+     * @param last Index after the last one.
+     * @param body Loop body, outlives the loop.
+     */
+    template <typename Body>
+    auto run(std::size_t first, std::size_t last, Body &body) -> void {
+        try {
+            auto local = body.local();
+            while (last - first > _grain &&
+                   !_failed.load(std::memory_order_relaxed)) {
+                if (_pool->starving()) {
+                    auto mid = first + ((last - first) / 2);
+                    _spawn(mid, last, body);
+                    last = mid;
+                    continue;
+                }
+
+                body.chunk(local, first, first + _grain);
+                first += _grain;
+            }
+
+            if (!_failed.load(std::memory_order_relaxed)) {
+                body.chunk(local, first, last);
+                body.merge(std::move(local));
+            }
+        } catch (...) {
+            if (!_failed.exchange(true)) {
+                _error = std::current_exception();
+            }
+        }
+
+        _latch.done();
+    }
+
+    /**
+     * @brief Wait for all pieces, a worker of the pool runs queued tasks
+     * meanwhile, other threads block (see `HelpLatch::wait`).
+     *
+     * @throw The first error of the loop body.
+     */
+    auto wait() -> void {
+        _latch.wait(*_pool);
+
+        if (_error != nullptr) {
+            std::rethrow_exception(_error);
+        }
+    }
+
+  private:
+    template <typename Body>
+    auto _spawn(std::size_t first, std::size_t last, Body &body) -> void {
+        // Our own piece keeps the counter above zero meanwhile.
+        _latch.add();
+        try {
+            _pool->post(
+                [this, first, last, &body]() { run(first, last, body); });
+        } catch (...) {
+            _latch.cancel();
+            throw;
+        }
+    }
+};
+
+/**
+ * @brief Body of `parallel_for`.
+ *
+ */
+template <typename It, typename F> class ForBody {
+  private:
+    It _first;
+    F *_func;
+
+  public:
+    struct Local {};
+
+    ForBody(It first, F &func) : _first(first), _func(&func) {}
+
+    [[nodiscard]] NEXUS_INLINE static auto local() -> Local { return {}; }
+
+    NEXUS_INLINE auto chunk(Local & /*local*/, std::size_t first,
+                            std::size_t last) -> void {
+        for (auto i = first; i < last; ++i) {
+            std::invoke(*_func,
+                        _first[static_cast<std::iter_difference_t<It>>(i)]);
+        }
+    }
+
+    NEXUS_INLINE static auto merge(Local && /*local*/) -> void {}
+};
+
+/**
+ * @brief Body of `transform_reduce`, each piece folds into a local partial,
+ * partials are merged under a lock once per piece.
+ *
+ */
+template <typename It, typename T, typename Reduce, typename Transform>
+class ReduceBody {
+  private:
+    It         _first;
+    Reduce    *_reduce;
+    Transform *_transform;
+
+    std::mutex       _lock;
+    std::optional<T> _result;
+
+  public:
+    using Local = std::optional<T>;
+
+    ReduceBody(It first, Reduce &reduce, Transform &transform)
+        : _first(first), _reduce(&reduce), _transform(&transform) {}
+
+    [[nodiscard]] NEXUS_INLINE static auto local() -> Local { return {}; }
+
+    auto chunk(Local &acc, std::size_t first, std::size_t last) -> void {
+        if (first == last) {
+            return;
+        }
+
+        auto idx = first;
+        if (!acc.has_value()) {
+            acc.emplace(_apply(idx++));
+        }
+        for (; idx < last; ++idx) {
+            *acc = std::invoke(*_reduce, std::move(*acc), _apply(idx));
+        }
+    }
+
+    auto merge(Local &&acc) -> void {
+        if (!acc.has_value()) {
+            return;
+        }
+
+        auto guard = std::lock_guard(_lock);
+        if (_result.has_value()) {
+            *_result =
+                std::invoke(*_reduce, std::move(*_result), std::move(*acc));
+        } else {
+            _result = std::move(acc);
+        }
+    }
+
+    /**
+     * @brief Fold the merged result into the initial value.
+     *
+     */
+    auto result(T init) -> T {
+        if (!_result.has_value()) {
+            return init;
+        }
+        return std::invoke(*_reduce, std::move(init), std::move(*_result));
+    }
+
+  private:
+    NEXUS_INLINE auto _apply(std::size_t idx) -> T {
+        return std::invoke(*_transform,
+                           _first[static_cast<std::iter_difference_t<It>>(
+                               idx)]);
+    }
+};
+
+/**
+ * @brief Run a loop body over `[0, size)` with the caller as the first piece.
+ *
+ */
+template <typename Body>
+auto parallel_run(ThreadPool &pool, std::size_t size, std::size_t grain,
+                  Body &body) -> void {
+    if (size == 0) {
+        return;
+    }
+
+    if (grain == 0) {
+        grain = std::max<std::size_t>(1, size / PARALLEL_AUTO_CHUNKS);
+    }
+
+    auto loop = ParallelLoop(pool, grain);
+    loop.run(0, size, body);
+    loop.wait();
+}
+
+} // namespace detail
+
+/**
+ * @brief Call `func` on each element of a range, in parallel on the pool and
+ * the calling thread. Work is split lazily, only while the pool is starving
+ * (see `ThreadPool::starving`).
+ *
+ * @tparam R Range type.
+ * @tparam F Function type.
+ * @param pool Thread pool.
+ * @param range Random access range, `std::views::iota` for indexes.
+ * @param func Function, called with each element.
+ * @param grain Elements run between two checks of the pool, 0 for
+ * `size / 1024`.
+ *
+ * @throw The first error of `func`, remaining elements may be skipped.
+ */
+template <std::ranges::random_access_range R, typename F>
+    requires std::ranges::sized_range<R>
+auto parallel_for(ThreadPool &pool, R &&range, F &&func,
+                  std::size_t grain = 0) -> void {
+    using It = std::ranges::iterator_t<R>;
+
+    auto body = detail::ForBody<It, std::remove_reference_t<F>>(
+        std::ranges::begin(range), func);
+    detail::parallel_run(pool, std::ranges::size(range), grain, body);
+}
+
+/**
+ * @brief Transform each element of a range and reduce the results, in
+ * parallel on the pool and the calling thread.
+ *
+ * @tparam R Range type.
+ * @tparam T Value type.
+ * @tparam Reduce Reduce function type.
+ * @tparam Transform Transform function type.
+ * @param pool Thread pool.
+ * @param range Random access range.
+ * @param init Initial value, reduced once.
+ * @param reduce Reduce function, should be associative and commutative.
+ * @param transform Transform function.
+ * @param grain Elements run between two checks of the pool, 0 for
+ * `size / 1024`.
+ * @return T Reduced value.
+ *
+ * @throw The first error of `reduce` or `transform`.
+ */
+template <std::ranges::random_access_range R, typename T, typename Reduce,
+          typename Transform>
+    requires std::ranges::sized_range<R>
+auto transform_reduce(ThreadPool &pool, R &&range, T init, Reduce reduce,
+                      Transform transform, std::size_t grain = 0) -> T {
+    using It = std::ranges::iterator_t<R>;
+
+    auto body = detail::ReduceBody<It, T, Reduce, Transform>(
+        std::ranges::begin(range), reduce, transform);
+    detail::parallel_run(pool, std::ranges::size(range), grain, body);
+
+    return body.result(std::move(init));
+}
+
+/**
+ * @brief Reduce the elements of a range, in parallel on the pool and the
+ * calling thread.
+ *
+ * @tparam R Range type.
+ * @tparam T Value type.
+ * @tparam Reduce Reduce function type.
+ * @param pool Thread pool.
+ * @param range Random access range.
+ * @param init Initial value, reduced once.
+ * @param reduce Reduce function, should be associative and commutative.
+ * @param grain Elements run between two checks of the pool, 0 for
+ * `size / 1024`.
+ * @return T Reduced value.
+ *
+ * @throw The first error of `reduce`.
+ */
+template <std::ranges::random_access_range R, typename T,
+          typename Reduce = std::plus<>>
+    requires std::ranges::sized_range<R>
+auto parallel_reduce(ThreadPool &pool, R &&range, T init, Reduce reduce = {},
+                     std::size_t grain = 0) -> T {
+    return transform_reduce(pool, std::forward<R>(range), std::move(init),
+                            std::move(reduce), std::identity(), grain);
+}
+
+} // namespace nexus::exec
@@ -3,15 +3,34 @@
 #include "nexus/common.hpp"
 #include "nexus/exec/policy.hpp"
 #include "nexus/exec/queue.hpp"
+#include "nexus/exec/task.hpp"
+#include "nexus/exec/thread/cancel.hpp"
+#include "nexus/exec/thread/group.hpp"
+#include "nexus/exec/thread/metrics.hpp"
+#include "nexus/exec/thread/numa.hpp"
+#include "nexus/exec/thread/timer.hpp"
 #include "nexus/exec/thread/worker.hpp"
+#include "nexus/private/exec/task.hpp"
 
+#include <chrono>
+#include <coroutine>
 #include <cstddef>
+#include <cstdint>
 #include <deque>
+#include <functional>
 #include <future>
 #include <list>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace nexus::exec {
 
@@ -39,6 +58,12 @@ class NEXUS_EXPORT ThreadPool {
      */
     using QueuePtr = std::shared_ptr<TaskQueue>;
 
+    constexpr static auto DEFAULT_SCALE_INTERVAL =
+        std::chrono::milliseconds(10);
+    constexpr static std::size_t DEFAULT_GROW_DEPTH = 8;
+    constexpr static auto DEFAULT_MAX_WAIT = std::chrono::microseconds(1000);
+    constexpr static auto DEFAULT_KEEP_ALIVE = std::chrono::milliseconds(5000);
+
     /**
      * @brief Thread pool status report.
      *
@@ -47,6 +72,46 @@ class NEXUS_EXPORT ThreadPool {
         std::size_t running;
         std::size_t cancel_wait;
         std::size_t cancelled;
+        PoolMetrics metrics; /**< Task and worker metrics. */
+    };
+
+    /**
+     * @brief Autoscaler configuration.
+     *
+     * @note The pool grows by half of its workers (at least one) when the
+     * queue is deeper than `grow_depth` tasks per worker, or when the queue
+     * wait estimated from throughput (Little's law) exceeds `max_wait`. It
+     * shrinks each node by its workers that stayed parked through a whole
+     * `keep_alive` window, parked ones first and never below one worker per
+     * node, and never within `keep_alive` after growing. New workers go to
+     * the node with the fewest workers.
+     */
+    struct AutoScale {
+        bool enabled{false}; /**< Run the autoscaler thread. */
+
+        /**
+         * @brief Interval between two checks.
+         *
+         */
+        std::chrono::milliseconds interval{DEFAULT_SCALE_INTERVAL};
+
+        /**
+         * @brief Queued tasks per worker to grow the pool.
+         *
+         */
+        std::size_t grow_depth{DEFAULT_GROW_DEPTH};
+
+        /**
+         * @brief Estimated queue wait to grow the pool.
+         *
+         */
+        std::chrono::microseconds max_wait{DEFAULT_MAX_WAIT};
+
+        /**
+         * @brief Idle time before a worker is removed.
+         *
+         */
+        std::chrono::milliseconds keep_alive{DEFAULT_KEEP_ALIVE};
     };
 
     /**
@@ -59,6 +124,109 @@ class NEXUS_EXPORT ThreadPool {
         std::size_t min_workers;  /**< Min workers (threads). */
         std::size_t init_workers; /**< Init workers (threads). */
         bool remove_cancelled; /**< Remove cancelled workers in next resize. */
+
+        /**
+         * @brief Queue capacity (RING only). A push to a full queue waits for
+         * a free slot, a worker of the queue (e.g. posting from a task) runs
+         * queued tasks inline meanwhile, so workers never all wait on their
+         * own queue.
+         *
+         */
+        std::size_t capacity{TaskQueue::DEFAULT_CAPACITY};
+
+        /**
+         * @brief Max tasks a worker takes from the queue at once, larger
+         * batches amortize queue locking for tiny tasks.
+         *
+         */
+        std::size_t batch_size{1};
+
+        /**
+         * @brief What a worker does when the queue is empty.
+         *
+         */
+        IdlePolicy idle_policy{IdlePolicy::Block};
+
+        /**
+         * @brief Max spin iterations of an idle worker before parking (Spin
+         * and Adaptive only).
+         *
+         */
+        std::size_t spin_count{ThreadWorker::DEFAULT_SPIN_COUNT};
+
+        /**
+         * @brief Handler of errors thrown by posted tasks.
+         *
+         */
+        TaskQueue::ErrorHandler error_handler;
+
+        /**
+         * @brief What a worker does with a task taken after its deadline.
+         *
+         */
+        MissPolicy miss_policy{MissPolicy::Run};
+
+        /**
+         * @brief Handler of missed tasks (`MissPolicy::Handle` only).
+         *
+         */
+        TaskQueue::MissHandler miss_handler;
+
+        /**
+         * @brief NUMA nodes, the pool keeps one queue per node and pins
+         * workers to the cpus of their node. Empty for a single queue without
+         * pinning.
+         *
+         */
+        std::vector<NumaNode> nodes;
+
+        /**
+         * @brief Cpus workers are pinned to, ignored if `nodes` is set. Empty
+         * for no pinning.
+         *
+         */
+        std::vector<std::size_t> cpus;
+
+        /**
+         * @brief Pin worker `i` to `cpus[i % cpus.size()]` instead of
+         * pinning every worker to the whole set.
+         *
+         */
+        bool pin_per_worker{false};
+
+        /**
+         * @brief `SCHED_FIFO` priority of workers, 0 keeps the default
+         * scheduling policy.
+         *
+         */
+        int fifo_priority{0};
+
+        /**
+         * @brief Nice value of workers, empty keeps the nice value of the
+         * creator.
+         *
+         */
+        std::optional<int> nice;
+
+        /**
+         * @brief Stack size of workers in bytes, 0 for the system default.
+         *
+         */
+        std::size_t stack_size{0};
+
+        /**
+         * @brief Worker thread name prefix, workers are named `<prefix><i>`
+         * (truncated to 15 characters). Empty keeps the inherited name.
+         *
+         */
+        std::string name_prefix;
+
+        /**
+         * @brief Grow and shrink workers between `min_workers` and
+         * `max_workers` automatically.
+         *
+         */
+        AutoScale autoscale;
     };
 
     class Builder {
@@ -91,6 +259,77 @@ class NEXUS_EXPORT ThreadPool {
             return *this;
         }
 
+        NEXUS_INLINE auto capacity(std::size_t cnt) -> Builder & {
+            _cfg.capacity = cnt;
+            return *this;
+        }
+
+        NEXUS_INLINE auto batch_size(std::size_t cnt) -> Builder & {
+            _cfg.batch_size = cnt;
+            return *this;
+        }
+
+        NEXUS_INLINE auto idle_policy(IdlePolicy policy) -> Builder & {
+            _cfg.idle_policy = policy;
+            return *this;
+        }
+
+        NEXUS_INLINE auto spin_count(std::size_t cnt) -> Builder & {
+            _cfg.spin_count = cnt;
+            return *this;
+        }
+
+        NEXUS_INLINE auto error_handler(TaskQueue::ErrorHandler handler)
+            -> Builder & {
+            _cfg.error_handler = std::move(handler);
+            return *this;
+        }
+
+        NEXUS_INLINE auto miss_policy(MissPolicy policy,
+                                      TaskQueue::MissHandler handler = {})
+            -> Builder & {
+            _cfg.miss_policy = policy;
+            _cfg.miss_handler = std::move(handler);
+            return *this;
+        }
+
+        NEXUS_INLINE auto nodes(std::vector<NumaNode> nodes) -> Builder & {
+            _cfg.nodes = std::move(nodes);
+            return *this;
+        }
+
+        NEXUS_INLINE auto cpus(std::vector<std::size_t> cpus,
+                               bool per_worker = false) -> Builder & {
+            _cfg.cpus = std::move(cpus);
+            _cfg.pin_per_worker = per_worker;
+            return *this;
+        }
+
+        NEXUS_INLINE auto fifo_priority(int prio) -> Builder & {
+            _cfg.fifo_priority = prio;
+            return *this;
+        }
+
+        NEXUS_INLINE auto nice(int value) -> Builder & {
+            _cfg.nice = value;
+            return *this;
+        }
+
+        NEXUS_INLINE auto stack_size(std::size_t size) -> Builder & {
+            _cfg.stack_size = size;
+            return *this;
+        }
+
+        NEXUS_INLINE auto name_prefix(std::string prefix) -> Builder & {
+            _cfg.name_prefix = std::move(prefix);
+            return *this;
+        }
+
+        NEXUS_INLINE auto autoscale(const AutoScale &scale) -> Builder & {
+            _cfg.autoscale = scale;
+            return *this;
+        }
+
         [[nodiscard]] NEXUS_INLINE auto provide() const -> const Config & {
             return _cfg;
         }
@@ -101,12 +340,49 @@ class NEXUS_EXPORT ThreadPool {
   private:
     Config _cfg;
 
-    QueuePtr                 _queue;
+    /**
+     * @brief One queue per NUMA node, or a single queue.
+     *
+     */
+    std::vector<QueuePtr> _queues;
+
+    /**
+     * @brief Cpu id to queue index, tasks without node hint go to the queue
+     * of the submitting cpu.
+     *
+     */
+    std::vector<std::size_t> _cpu_node;
+
+    /**
+     * @brief Timers, declared before the workers so that running timers
+     * finish before it is destroyed.
+     *
+     */
+    std::unique_ptr<detail::TimerWheel> _timers;
+
+    /**
+     * @brief Workers created so far, used to name workers and to spread
+     * them over cpus without nodes.
+     *
+     */
+    std::size_t _spawned{0};
+
     std::deque<ThreadWorker> _workers;
     std::list<ThreadWorker>  _cancelled_workers;
 
+    /**
+     * @brief Metrics of removed workers.
+     *
+     */
+    PoolMetrics _retired;
+
+    std::chrono::steady_clock::time_point _created{
+        std::chrono::steady_clock::now()};
+
     std::mutex _lock;
 
+    std::jthread _scaler;
+
   public:
     ThreadPool(const Config &cfg);
 
@@ -126,6 +402,27 @@ class NEXUS_EXPORT ThreadPool {
      */
     auto push(TaskType &&task) -> std::future<Result>;
 
+    /**
+     * @brief Add a task to the queue of a NUMA node.
+     *
+     * @param task Task object.
+     * @param node Node index in `Config::nodes`.
+     * @return std::future<Result> Task future.
+     *
+     * @throw std::out_of_range Node index is out of range.
+     */
+    auto push(TaskType &&task, std::size_t node) -> std::future<Result>;
+
+    /**
+     * @brief Add tasks to the queue under one lock acquisition.
+     *
+     * @param tasks Task objects, moved into the queue.
+     * @return std::vector<std::future<Result>> Task futures, in the same
+     * order as `tasks` (invalid for detached tasks).
+     */
+    auto push_bulk(std::span<TaskType> tasks)
+        -> std::vector<std::future<Result>>;
+
     /**
      * @brief Resize the workers queue.
      *
@@ -158,6 +455,386 @@ class NEXUS_EXPORT ThreadPool {
         return push(TaskType(std::forward<Args>(args)...));
     }
 
+    /**
+     * @brief Add a task to the queue with typed result, the result is passed
+     * to the future directly instead of being boxed into `Result`.
+     *
+     * @tparam F Function type.
+     * @tparam Args Arguments type.
+     * @param func Function.
+     * @param args Arguments.
+     * @return std::future<detail::TaskResult<F, Args...>> Task future.
+     *
+     * @note All reference type will be decayed.
+     */
+    template <typename F, typename... Args>
+    NEXUS_INLINE auto submit(F &&func, Args &&...args)
+        -> std::future<detail::TaskResult<F, Args...>> {
+        return submit_on(_local_node(), std::forward<F>(func),
+                         std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Add a task with typed result to the queue of a NUMA node.
+     *
+     * @tparam F Function type.
+     * @tparam Args Arguments type.
+     * @param node Node index in `Config::nodes`.
+     * @param func Function.
+     * @param args Arguments.
+     * @return std::future<detail::TaskResult<F, Args...>> Task future.
+     *
+     * @throw std::out_of_range Node index is out of range.
+     */
+    template <typename F, typename... Args>
+    auto submit_on(std::size_t node, F &&func, Args &&...args)
+        -> std::future<detail::TaskResult<F, Args...>> {
+        using R = detail::TaskResult<F, Args...>;
+        using Binder = typename detail::TaskHelper<F, R, Args...>::Binder;
+
+        auto res =
+            std::promise<R>(std::allocator_arg, detail::PoolAllocator<R>());
+        auto fut = res.get_future();
+
+        // The queue only sees a detached task, the typed promise lives in it.
+        _queues.at(node)->post(
+            [binder =
+                 Binder(std::forward<F>(func), std::forward<Args>(args)...),
+             res = std::move(res)]() mutable { binder(&res); });
+        _wakeup_stealer(node);
+
+        return fut;
+    }
+
+    /**
+     * @brief Add a task that can be cancelled, the function gets a stop token
+     * as first argument if it accepts one.
+     *
+     * @tparam F Function type.
+     * @tparam Args Arguments type.
+     * @param func Function, invocable with `(std::stop_token, args...)` or
+     * `(args...)`.
+     * @param args Arguments.
+     * @return Cancellable<detail::CancelResult<F, Args...>> Task future and
+     * cancel handle.
+     *
+     * @note All reference type will be decayed.
+     */
+    template <typename F, typename... Args>
+    auto submit_cancellable(F &&func, Args &&...args)
+        -> Cancellable<detail::CancelResult<F, Args...>> {
+        using R = detail::CancelResult<F, Args...>;
+
+        auto state = std::make_shared<detail::CancelState>();
+        auto res =
+            std::promise<R>(std::allocator_arg, detail::PoolAllocator<R>());
+        auto fut = res.get_future();
+
+        // A cancelled task is skipped, dropping the promise breaks the future.
+        post([state, func = std::decay_t<F>(std::forward<F>(func)),
+              ... args = std::decay_t<Args>(std::forward<Args>(args)),
+              res = std::move(res)]() mutable {
+            if (!state->start()) {
+                return;
+            }
+
+            try {
+                auto call = [&]() -> R {
+                    if constexpr (std::is_invocable_v<std::decay_t<F> &,
+                                                      std::stop_token,
+                                                      std::decay_t<Args>...>) {
+                        return std::invoke(func, state->token(),
+                                           std::move(args)...);
+                    } else {
+                        return std::invoke(func, std::move(args)...);
+                    }
+                };
+
+                if constexpr (std::is_void_v<R>) {
+                    call();
+                    res.set_value();
+                } else {
+                    res.set_value(call());
+                }
+            } catch (...) {
+                res.set_exception(std::current_exception());
+            }
+        });
+
+        return {.future = std::move(fut),
+                .handle = CancelHandle(std::move(state))};
+    }
+
+    /**
+     * @brief Add a detached task to the queue, which has no future, error of
+     * the task is passed to `Config::error_handler`.
+     *
+     * @tparam F Function type.
+     * @tparam Args Arguments type.
+     * @param func Function.
+     * @param args Arguments.
+     *
+     * @note All reference type will be decayed.
+     */
+    template <typename F, typename... Args>
+    NEXUS_INLINE auto post(F &&func, Args &&...args) -> void {
+        post_on(_local_node(), std::forward<F>(func),
+                std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Add a detached task to the queue of a NUMA node.
+     *
+     * @tparam F Function type.
+     * @tparam Args Arguments type.
+     * @param node Node index in `Config::nodes`.
+     * @param func Function.
+     * @param args Arguments.
+     *
+     * @throw std::out_of_range Node index is out of range.
+     */
+    template <typename F, typename... Args>
+    auto post_on(std::size_t node, F &&func, Args &&...args) -> void {
+        _queues.at(node)->post(std::forward<F>(func),
+                               std::forward<Args>(args)...);
+        _wakeup_stealer(node);
+    }
+
+    /**
+     * @brief Run two functions in parallel: `rhs` is spawned, `lhs` runs on
+     * the calling thread, which then helps until `rhs` is done. Safe to nest
+     * in pool tasks, see `TaskGroup`.
+     *
+     * @tparam A Function type of `lhs`.
+     * @tparam B Function type of `rhs`.
+     * @param lhs Function run on the calling thread.
+     * @param rhs Function spawned on the pool.
+     * @return std::pair<detail::ForkValue<A>, detail::ForkValue<B>> Results,
+     * `std::monostate` for void.
+     *
+     * @throw The error of `lhs`, or else of `rhs`.
+     */
+    template <typename A, typename B>
+    auto fork_join(A &&lhs, B &&rhs)
+        -> std::pair<detail::ForkValue<A>, detail::ForkValue<B>> {
+        // Declared before the group, which waits for `rhs` on unwinding.
+        auto rhs_val = std::optional<detail::ForkValue<B>>();
+
+        auto group = TaskGroup(*this);
+        group.spawn(
+            [&rhs, &rhs_val]() { rhs_val.emplace(detail::fork_call(rhs)); });
+        auto lhs_val = detail::fork_call(lhs);
+        group.wait();
+
+        return {std::move(lhs_val), std::move(*rhs_val)};
+    }
+
+    /**
+     * @brief Awaiter of `schedule()`, the suspended coroutine is posted as a
+     * detached task owning it.
+     *
+     * @note A dropped task destroys the outermost frame of the await chain,
+     * if the promise tells it by `root()` (`CoTask` and `co_spawn` do), which
+     * breaks the future of `co_spawn`. Other coroutines are not destroyed,
+     * their owner is unknown.
+     */
+    class ScheduleAwaiter {
+      private:
+        /**
+         * @brief Posted task, resumes the coroutine or destroys its chain if
+         * it never runs.
+         *
+         */
+        class Resume {
+          private:
+            std::coroutine_handle<> _handle;
+            std::coroutine_handle<> _root;
+
+          public:
+            Resume(std::coroutine_handle<> handle,
+                   std::coroutine_handle<> root)
+                : _handle(handle), _root(root) {}
+
+            ~Resume() {
+                if (_root) {
+                    _root.destroy();
+                }
+            }
+
+            Resume(const Resume &other) = delete;
+            auto operator=(const Resume &other) -> Resume & = delete;
+
+            Resume(Resume &&other) noexcept
+                : _handle(std::exchange(other._handle, nullptr)),
+                  _root(std::exchange(other._root, nullptr)) {}
+            auto operator=(Resume &&other) -> Resume & = delete;
+
+            NEXUS_INLINE auto operator()() -> void {
+                _root = nullptr;
+                std::exchange(_handle, nullptr).resume();
+            }
+        };
+
+        ThreadPool *_pool;
+        std::size_t _node;
+
+      public:
+        ScheduleAwaiter(ThreadPool *pool, std::size_t node)
+            : _pool(pool), _node(node) {}
+
+        [[nodiscard]] NEXUS_INLINE static auto await_ready() noexcept
+            -> bool {
+            return false;
+        }
+
+        template <typename P>
+        NEXUS_INLINE auto await_suspend(std::coroutine_handle<P> handle)
+            -> void {
+            auto root = std::coroutine_handle<>();
+            if constexpr (requires { handle.promise().root(); }) {
+                root = handle.promise().root();
+            }
+            _pool->post_on(_node, Resume(handle, root));
+        }
+
+        NEXUS_INLINE static auto await_resume() noexcept -> void {}
+    };
+
+    /**
+     * @brief Get an awaitable resuming the awaiting coroutine on a worker,
+     * `co_await pool.schedule()` hops onto the pool, or yields if already on
+     * it.
+     *
+     * @return ScheduleAwaiter Awaitable.
+     */
+    [[nodiscard]] NEXUS_INLINE auto schedule() -> ScheduleAwaiter {
+        return {this, _local_node()};
+    }
+
+    /**
+     * @brief Get an awaitable resuming the awaiting coroutine on a worker of
+     * a NUMA node.
+     *
+     * @param node Node index in `Config::nodes`.
+     * @return ScheduleAwaiter Awaitable.
+     *
+     * @throw std::out_of_range Node index is out of range.
+     */
+    [[nodiscard]] auto schedule_on(std::size_t node) -> ScheduleAwaiter {
+        if (node >= _queues.size()) {
+            throw std::out_of_range("node index is out of range");
+        }
+        return {this, node};
+    }
+
+    /**
+     * @brief Post a function to the pool after a delay.
+     *
+     * @tparam Rep Duration representation.
+     * @tparam Period Duration period.
+     * @tparam F Function type.
+     * @param delay Delay, rounded up to the timer tick (1ms).
+     * @param func Function, errors are passed to `Config::error_handler`.
+     * @return TimerHandle Handle to cancel the timer.
+     */
+    template <typename Rep, typename Period, typename F>
+    auto schedule_after(std::chrono::duration<Rep, Period> delay, F &&func)
+        -> TimerHandle {
+        auto wait =
+            std::chrono::ceil<std::chrono::steady_clock::duration>(delay);
+        return schedule_at(std::chrono::steady_clock::now() + wait,
+                           std::forward<F>(func));
+    }
+
+    /**
+     * @brief Post a function to the pool at a time point.
+     *
+     * @tparam F Function type.
+     * @param deadline Time point, a past one posts at once.
+     * @param func Function.
+     * @return TimerHandle Handle to cancel the timer.
+     */
+    template <typename F>
+    auto schedule_at(std::chrono::steady_clock::time_point deadline,
+                     F &&func) -> TimerHandle {
+        return _schedule(deadline, std::chrono::steady_clock::duration::zero(),
+                         detail::TaskFunction<void()>(std::forward<F>(func)));
+    }
+
+    /**
+     * @brief Post a function to the pool periodically at a fixed rate, the
+     * first run is one period from now. A run starts after the previous one
+     * finishes, missed runs are skipped.
+     *
+     * @tparam Rep Duration representation.
+     * @tparam Period Duration period.
+     * @tparam F Function type.
+     * @param period Period.
+     * @param func Function.
+     * @return TimerHandle Handle to stop the timer.
+     *
+     * @throw std::invalid_argument Period is not positive.
+     */
+    template <typename Rep, typename Period, typename F>
+    auto schedule_every(std::chrono::duration<Rep, Period> period, F &&func)
+        -> TimerHandle {
+        auto interval =
+            std::chrono::ceil<std::chrono::steady_clock::duration>(period);
+        if (interval <= std::chrono::steady_clock::duration::zero()) {
+            throw std::invalid_argument("period should be positive");
+        }
+        return _schedule(std::chrono::steady_clock::now() + interval,
+                         interval,
+                         detail::TaskFunction<void()>(std::forward<F>(func)));
+    }
+
+    /**
+     * @brief Get count of pending timers.
+     *
+     * @return std::size_t Pending timers.
+     */
+    [[nodiscard]] auto timers() const -> std::size_t;
+
+    /**
+     * @brief Check if some worker is idle: the queue of the calling node is
+     * empty and a worker is parked on it. Used to split work lazily, only
+     * when someone can take it.
+     *
+     * @note Spinning workers are not counted, with `IdlePolicy::Spin` or
+     * `Adaptive` an empty queue is enough. Idle workers of other nodes are
+     * not counted either.
+     */
+    [[nodiscard]] NEXUS_INLINE auto starving() const -> bool {
+        const auto &queue = _queues[_local_node()];
+        return queue->empty() &&
+               (queue->parked() != 0 || _cfg.idle_policy != IdlePolicy::Block);
+    }
+
+    /**
+     * @brief Run one queued task on the calling thread, the queue of the
+     * calling node is tried first. A thread waiting for tasks of the pool
+     * helps with it instead of blocking a worker.
+     *
+     * @return true A task is taken (run, or handled as a deadline miss).
+     * @return false All queues are empty.
+     */
+    auto try_run_one() -> bool;
+
+    /**
+     * @brief Check if calling thread is a worker of the pool.
+     *
+     */
+    [[nodiscard]] auto is_worker() const -> bool;
+
+    /**
+     * @brief Get count of queues (NUMA nodes).
+     *
+     * @return std::size_t Queue count.
+     */
+    [[nodiscard]] NEXUS_INLINE auto nodes() const -> std::size_t {
+        return _queues.size();
+    }
+
     /**
      * @brief Get thread pool status.
      *
@@ -167,21 +844,124 @@ class NEXUS_EXPORT ThreadPool {
 
   private:
     /**
-     * @brief Reuse cancelled workers.
+     * @brief State of the autoscaler between two checks.
      *
-     * @param need Workers count to be reused.
-     * @return std::size_t Workers that are actually reused.
      */
-    auto _reuse_workers(std::size_t need) -> std::size_t;
+    struct ScaleState {
+        std::chrono::steady_clock::time_point last_check;
+        std::chrono::steady_clock::time_point last_grow;
+        std::chrono::steady_clock::time_point window_start;
+        std::uint64_t                         executed{0};
+
+        /**
+         * @brief Min parked workers of each node in the current window.
+         *
+         */
+        std::vector<std::size_t> min_parked;
+    };
+
+    /**
+     * @brief Add a timer to the wheel.
+     *
+     */
+    auto _schedule(std::chrono::steady_clock::time_point deadline,
+                   std::chrono::steady_clock::duration   period,
+                   detail::TaskFunction<void()>        &&func) -> TimerHandle;
+
+    /**
+     * @brief Resize workers, `_lock` should be held.
+     *
+     * @param new_size New workers size.
+     */
+    auto _resize(std::size_t new_size) -> void;
 
     /**
-     * @brief Cancel workers.
+     * @brief Autoscaler thread loop.
+     *
+     * @param stop Stop token of the thread.
+     */
+    auto _autoscale_loop(const std::stop_token &stop) -> void;
+
+    /**
+     * @brief Check load and resize workers once.
+     *
+     * @param state Autoscaler state.
+     */
+    auto _autoscale(ScaleState &state) -> void;
+
+    /**
+     * @brief Get tasks executed by all workers, `_lock` should be held.
+     *
+     * @return std::uint64_t Executed tasks.
+     */
+    [[nodiscard]] auto _executed() const -> std::uint64_t;
+
+    /**
+     * @brief Get queue index of the calling cpu.
+     *
+     * @return std::size_t Queue index, 0 if there is only one queue.
+     */
+    [[nodiscard]] auto _local_node() const -> std::size_t;
+
+    /**
+     * @brief Wake up a parked worker of another node if no worker of `node`
+     * is parked, so it can steal the task just pushed.
+     *
+     * @param node Queue index the task was pushed to.
+     */
+    auto _wakeup_stealer(std::size_t node) -> void;
+
+    /**
+     * @brief Create a worker on a node, pinned to the next cpu of it.
+     *
+     * @param node Queue index.
+     */
+    auto _spawn_worker(std::size_t node) -> void;
+
+    /**
+     * @brief Reuse a cancelled worker of a node.
+     *
+     * @param node Queue index.
+     * @return true A worker is reused.
+     * @return false The node has no cancelled worker.
+     */
+    auto _reuse_worker(std::size_t node) -> bool;
+
+    /**
+     * @brief Cancel workers, one at a time from the node with the most
+     * workers.
      *
      * @param need Workers count to be cancelled.
      * @return std::size_t Workers that are actually cancelled.
      */
     auto _cancel_workers(std::size_t need) -> std::size_t;
 
+    /**
+     * @brief Cancel workers of a node, parked ones first.
+     *
+     * @param node Queue index.
+     * @param need Workers count to be cancelled.
+     * @return std::size_t Workers that are actually cancelled.
+     */
+    auto _cancel_node_workers(std::size_t node, std::size_t need)
+        -> std::size_t;
+
+    /**
+     * @brief Get queue index of a worker.
+     *
+     * @param worker Worker.
+     * @return std::size_t Queue index.
+     */
+    [[nodiscard]] auto _node_of(const ThreadWorker &worker) const
+        -> std::size_t;
+
+    /**
+     * @brief Get count of running workers of each node.
+     *
+     * @return std::vector<std::size_t> Worker counts, by queue index.
+     */
+    [[nodiscard]] auto _node_workers() const -> std::vector<std::size_t>;
+
     /**
      * @brief Clean workers that already cancelled.
      *
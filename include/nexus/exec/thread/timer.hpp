@@ -0,0 +1,49 @@
+#pragma once
+
+#include "nexus/common.hpp"
+
+#include <cstdint>
+
+namespace nexus::exec {
+
+namespace detail {
+
+class TimerWheel;
+
+} // namespace detail
+
+/**
+ * @brief Handle of a timer scheduled on a thread pool.
+ *
+ * @note The handle should not outlive the pool.
+ */
+class NEXUS_EXPORT TimerHandle {
+  private:
+    detail::TimerWheel *_wheel{nullptr};
+    std::uint32_t       _id{0};
+    std::uint32_t       _gen{0};
+
+  public:
+    TimerHandle() = default;
+    TimerHandle(detail::TimerWheel *wheel, std::uint32_t id, std::uint32_t gen)
+        : _wheel(wheel), _id(id), _gen(gen) {}
+
+    /**
+     * @brief Check if the handle refers to a timer.
+     *
+     */
+    [[nodiscard]] NEXUS_INLINE auto valid() const -> bool {
+        return _wheel != nullptr;
+    }
+
+    /**
+     * @brief Cancel the timer in O(1).
+     *
+     * @return true A pending timer is removed, or a periodic timer will not
+     * run again.
+     * @return false The timer already started (one-shot) or was cancelled.
+     */
+    auto cancel() -> bool;
+};
+
+} // namespace nexus::exec
@@ -1,16 +1,24 @@
 #pragma once
 
 #include "nexus/common.hpp"
+#include "nexus/exec/policy.hpp"
 #include "nexus/exec/queue.hpp"
+#include "nexus/exec/thread/metrics.hpp"
+#include "nexus/private/exec/metrics.hpp"
+#include "nexus/private/exec/park.hpp"
+#include "nexus/private/exec/thread.hpp"
 
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <mutex>
-#include <thread>
+#include <optional>
+#include <string>
 #include <utility>
+#include <vector>
 
 namespace nexus::exec {
 
@@ -27,10 +35,10 @@ class NEXUS_EXPORT ThreadWorker {
     using QueuePtr = std::shared_ptr<TaskQueue>;
 
     /**
-     * @brief Jthread pointer type for lazy initialization.
+     * @brief Thread pointer type for lazy initialization.
      *
      */
-    using ThreadPtr = std::unique_ptr<std::jthread>;
+    using ThreadPtr = std::unique_ptr<detail::NativeThread>;
 
     /**
      * @brief Worker status.
@@ -51,6 +59,18 @@ class NEXUS_EXPORT ThreadWorker {
         std::atomic<Status>     status{Status::Create};
         std::mutex              lock;
         std::condition_variable cancel_notify;
+
+        /**
+         * @brief Parking slot on the queue, cancel wakes up only this worker.
+         *
+         */
+        detail::Parker parker;
+
+        /**
+         * @brief Worker statistics, written by the worker only.
+         *
+         */
+        detail::WorkerStats stats;
     };
 
     /**
@@ -59,16 +79,94 @@ class NEXUS_EXPORT ThreadWorker {
      */
     using InnerPtr = std::shared_ptr<Inner>;
 
+    /**
+     * @brief Default spin iterations of an idle worker.
+     *
+     */
+    constexpr static std::size_t DEFAULT_SPIN_COUNT = 2048;
+
+    /**
+     * @brief Worker configuration.
+     *
+     */
+    struct Config {
+        /**
+         * @brief Max tasks taken from the queue at once, the worker runs them
+         * before returning to the queue.
+         *
+         */
+        std::size_t batch_size{1};
+
+        /**
+         * @brief What the worker does when the queue is empty.
+         *
+         */
+        IdlePolicy idle_policy{IdlePolicy::Block};
+
+        /**
+         * @brief Max spin iterations before parking (Spin and Adaptive only).
+         *
+         */
+        std::size_t spin_count{DEFAULT_SPIN_COUNT};
+
+        /**
+         * @brief Cpus the worker is pinned to, empty for no pinning.
+         *
+         */
+        std::vector<std::size_t> cpus;
+
+        /**
+         * @brief Queues to steal from when the own queue is empty, e.g.
+         * queues of other NUMA nodes.
+         *
+         */
+        std::vector<QueuePtr> steal_from;
+
+        /**
+         * @brief `SCHED_FIFO` priority of the thread, 0 keeps the default
+         * scheduling policy.
+         *
+         */
+        int fifo_priority{0};
+
+        /**
+         * @brief Nice value of the thread, empty keeps the nice value of the
+         * creator.
+         *
+         */
+        std::optional<int> nice;
+
+        /**
+         * @brief Stack size in bytes, 0 for the system default.
+         *
+         */
+        std::size_t stack_size{0};
+
+        /**
+         * @brief Thread name, truncated to 15 characters, empty keeps the
+         * inherited name.
+         *
+         */
+        std::string name;
+    };
+
   private:
     QueuePtr  _queue;
     ThreadPtr _worker{nullptr};
     InnerPtr  _inner{std::make_shared<Inner>()};
+    Config    _cfg;
 
   public:
     ThreadWorker(QueuePtr &&queue) : _queue(std::move(queue)) {}
 
     ThreadWorker(const QueuePtr &queue) : _queue(queue) {}
 
+    ThreadWorker(QueuePtr &&queue, const Config &cfg)
+        : _queue(std::move(queue)), _cfg(cfg) {}
+
+    ThreadWorker(const QueuePtr &queue, const Config &cfg)
+        : _queue(queue), _cfg(cfg) {}
+
     ~ThreadWorker() = default;
 
     ThreadWorker(const ThreadWorker &other) = delete;
@@ -119,6 +217,43 @@ class NEXUS_EXPORT ThreadWorker {
         return _inner->status.load();
     }
 
+    /**
+     * @brief Get count of tasks executed by the worker.
+     *
+     * @return std::uint64_t Executed tasks.
+     */
+    [[nodiscard]] NEXUS_INLINE auto executed() const -> std::uint64_t {
+        return _inner->stats.executed.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the queue the worker takes tasks from.
+     *
+     * @return const QueuePtr& Queue.
+     */
+    [[nodiscard]] NEXUS_INLINE auto queue() const -> const QueuePtr & {
+        return _queue;
+    }
+
+    /**
+     * @brief Check if worker is parked on its queue, the result may be
+     * outdated.
+     *
+     * @return true Worker is parked.
+     * @return false Worker is not parked.
+     */
+    [[nodiscard]] NEXUS_INLINE auto parked() const -> bool {
+        return _inner->parker.parked.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Add histograms and counters of the worker to pool metrics.
+     *
+     * @param out Pool metrics, `workers` is not changed.
+     * @return WorkerMetrics Counters of the worker.
+     */
+    auto collect(PoolMetrics &out) const -> WorkerMetrics;
+
     /**
      * @brief Check if worker is in cancel wait.
      *
@@ -181,7 +316,29 @@ class NEXUS_EXPORT ThreadWorker {
      * @brief Worker loop, take task and execute it.
      *
      */
-    static auto _worker_loop(const QueuePtr &queue, InnerPtr &inner) -> void;
+    static auto _worker_loop(const QueuePtr &queue, InnerPtr &inner,
+                             const Config &cfg) -> void;
+
+    /**
+     * @brief Apply the miss policy of the queue to a task taken after its
+     * deadline, errors of the miss handler go to the error handler.
+     *
+     * @param queue Queue the task belongs to.
+     * @param task Missed task.
+     * @return true Task should run.
+     * @return false Task is dropped or handed over.
+     */
+    static auto _take_missed(TaskQueue &queue, TaskQueue::TaskType &task)
+        -> bool;
+
+    /**
+     * @brief Take one task from other queues.
+     *
+     * @param others Queues to steal from.
+     * @param batch Output buffer.
+     */
+    static auto _steal(const std::vector<QueuePtr> &others,
+                       std::vector<TaskQueue::TaskType> &batch) -> void;
 };
 
 } // namespace nexus::exec
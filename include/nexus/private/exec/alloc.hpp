@@ -0,0 +1,64 @@
+#pragma once
+
+#include "nexus/common.hpp"
+
+#include <cstddef>
+#include <new>
+
+namespace nexus::exec::detail {
+
+/**
+ * @brief Allocate memory from task pool, small blocks are recycled through
+ * thread local caches instead of `malloc`.
+ *
+ * @param size Block size.
+ * @return void* Block pointer.
+ */
+NEXUS_EXPORT auto pool_allocate(std::size_t size) -> void *;
+
+/**
+ * @brief Return memory to task pool.
+ *
+ * @param ptr Block pointer.
+ * @param size Block size, same as `pool_allocate`.
+ */
+NEXUS_EXPORT auto pool_deallocate(void *ptr, std::size_t size) -> void;
+
+/**
+ * @brief Allocator backed by task pool, used for task shared states.
+ *
+ * @tparam T Value type.
+ */
+template <typename T> class PoolAllocator {
+  public:
+    using value_type = T;
+
+    PoolAllocator() = default;
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U> & /*other*/) noexcept {}
+
+    [[nodiscard]] auto allocate(std::size_t cnt) -> T * {
+        if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            return static_cast<T *>(::operator new(
+                cnt * sizeof(T), std::align_val_t(alignof(T))));
+        } else {
+            return static_cast<T *>(pool_allocate(cnt * sizeof(T)));
+        }
+    }
+
+    auto deallocate(T *ptr, std::size_t cnt) -> void {
+        if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            ::operator delete(ptr, std::align_val_t(alignof(T)));
+        } else {
+            pool_deallocate(ptr, cnt * sizeof(T));
+        }
+    }
+
+    template <typename U>
+    auto operator==(const PoolAllocator<U> & /*other*/) const -> bool {
+        return true;
+    }
+};
+
+} // namespace nexus::exec::detail
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "nexus/common.hpp"
+#include "nexus/exec/task.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace nexus::exec::detail {
+
+/**
+ * @brief Growable FIFO ring of tasks, slots are reused after pop, so pushes
+ * only allocate when the ring grows.
+ *
+ */
+class TaskRing {
+  private:
+    constexpr static std::size_t INIT_CAPACITY = 8;
+
+    std::vector<std::optional<Task<>>> _slots;
+    std::size_t                        _head{0};
+    std::size_t                        _size{0};
+
+  public:
+    TaskRing() = default;
+
+    /**
+     * @brief Push task at the tail.
+     *
+     * @param task Task object.
+     */
+    auto push(Task<> &&task) -> void;
+
+    /**
+     * @brief Pop task from the head, ring should not be empty.
+     *
+     * @return Task<> Task object.
+     */
+    auto pop() -> Task<>;
+
+    /**
+     * @brief Get task count.
+     *
+     * @return std::size_t Task count.
+     */
+    [[nodiscard]] NEXUS_INLINE auto size() const -> std::size_t {
+        return _size;
+    }
+
+    /**
+     * @brief Get if ring is empty.
+     *
+     * @return true Ring is empty.
+     * @return false Ring is not empty.
+     */
+    [[nodiscard]] NEXUS_INLINE auto empty() const -> bool {
+        return _size == 0;
+    }
+
+  private:
+    /**
+     * @brief Double the capacity, tasks are moved in FIFO order.
+     *
+     */
+    auto _grow() -> void;
+};
+
+/**
+ * @brief Priority queue with one FIFO ring per priority level, and a bitmap
+ * of non-empty levels to find the highest priority in O(1).
+ *
+ * @note Tasks with the same priority are popped in push order.
+ */
+class TaskBucketQueue {
+  private:
+    constexpr static std::size_t LEVELS = 256;
+    constexpr static std::size_t WORD_BITS = 64;
+    constexpr static std::size_t WORDS = LEVELS / WORD_BITS;
+
+    std::array<TaskRing, LEVELS>     _buckets;
+    std::array<std::uint64_t, WORDS> _bitmap{};
+    std::size_t                      _size{0};
+
+  public:
+    TaskBucketQueue() = default;
+
+    /**
+     * @brief Push task to the bucket of its priority.
+     *
+     * @param task Task object.
+     */
+    auto push(Task<> &&task) -> void;
+
+    /**
+     * @brief Pop the oldest task with the highest priority, queue should not
+     * be empty.
+     *
+     * @return Task<> Task object.
+     */
+    auto pop() -> Task<>;
+
+    /**
+     * @brief Get task count.
+     *
+     * @return std::size_t Task count.
+     */
+    [[nodiscard]] NEXUS_INLINE auto size() const -> std::size_t {
+        return _size;
+    }
+
+  private:
+    /**
+     * @brief Map priority to bucket level, -128 is level 0.
+     *
+     * @param prio Task priority.
+     * @return std::size_t Bucket level.
+     */
+    NEXUS_INLINE constexpr static auto _level(std::int8_t prio)
+        -> std::size_t {
+        return static_cast<std::uint8_t>(prio) ^ 0x80U;
+    }
+
+    /**
+     * @brief Get the highest non-empty level, queue should not be empty.
+     *
+     * @return std::size_t Bucket level.
+     */
+    [[nodiscard]] auto _top_level() const -> std::size_t;
+};
+
+} // namespace nexus::exec::detail
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "nexus/exec/task.hpp"
+#include "nexus/private/exec/alloc.hpp"
+#include "nexus/private/exec/queue.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace nexus::exec::detail {
+
+/**
+ * @brief Destroy a boxed task and return its block to the task pool.
+ *
+ */
+struct TaskBoxDeleter {
+    NEXUS_INLINE auto operator()(Task<> *task) const noexcept -> void {
+        auto alloc = PoolAllocator<Task<>>();
+        task->~Task();
+        alloc.deallocate(task, 1);
+    }
+};
+
+/**
+ * @brief Chase-Lev work stealing deque. The owner thread pushes and pops at
+ * the bottom, other threads steal from the top.
+ *
+ * @note Tasks are boxed, a thief can not move a task out of its slot before
+ * it wins the race on that slot. Boxes come from the task pool, so a warm
+ * deque does not allocate.
+ */
+class TaskDeque {
+  public:
+    /**
+     * @brief Boxed task type.
+     *
+     */
+    using TaskPtr = std::unique_ptr<Task<>, TaskBoxDeleter>;
+
+  private:
+    /**
+     * @brief Circular array of boxed tasks.
+     *
+     */
+    struct Buffer {
+        std::int64_t                             mask;
+        std::unique_ptr<std::atomic<Task<> *>[]> slots;
+
+        explicit Buffer(std::int64_t capacity)
+            : mask(capacity - 1),
+              slots(std::make_unique<std::atomic<Task<> *>[]>(capacity)) {}
+
+        [[nodiscard]] NEXUS_INLINE auto capacity() const -> std::int64_t {
+            return mask + 1;
+        }
+
+        [[nodiscard]] NEXUS_INLINE auto get(std::int64_t idx) const
+            -> Task<> * {
+            return slots[idx & mask].load(std::memory_order_relaxed);
+        }
+
+        NEXUS_INLINE auto put(std::int64_t idx, Task<> *task) -> void {
+            slots[idx & mask].store(task, std::memory_order_relaxed);
+        }
+    };
+
+    constexpr static std::int64_t INIT_CAPACITY = 64;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<std::int64_t> _top{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<std::int64_t> _bottom{0};
+    std::atomic<Buffer *> _buffer;
+
+    /**
+     * @brief Buffers replaced by `_grow`, thieves may still read from them, so
+     * they live as long as the deque.
+     *
+     */
+    std::vector<std::unique_ptr<Buffer>> _buffers;
+
+  public:
+    TaskDeque();
+    ~TaskDeque();
+
+    TaskDeque(const TaskDeque &other) = delete;
+    auto operator=(const TaskDeque &other) -> TaskDeque & = delete;
+
+    TaskDeque(TaskDeque &&other) = delete;
+    auto operator=(TaskDeque &&other) -> TaskDeque & = delete;
+
+    /**
+     * @brief Box task and push it at the bottom (owner only).
+     *
+     * @param task Task.
+     */
+    auto push(Task<> &&task) -> void;
+
+    /**
+     * @brief Pop task from the bottom (owner only).
+     *
+     * @return TaskPtr Boxed task, nullptr if deque is empty.
+     */
+    auto pop() -> TaskPtr;
+
+    /**
+     * @brief Steal task from the top (any thread).
+     *
+     * @return TaskPtr Boxed task, nullptr if deque is empty or the race is
+     * lost.
+     */
+    auto steal() -> TaskPtr;
+
+    /**
+     * @brief Get if deque looks empty, the result may be outdated.
+     *
+     * @return true Deque is empty.
+     * @return false Deque is not empty.
+     */
+    [[nodiscard]] NEXUS_INLINE auto empty() const -> bool {
+        return _bottom.load(std::memory_order_relaxed) <=
+               _top.load(std::memory_order_relaxed);
+    }
+
+  private:
+    /**
+     * @brief Replace buffer with a larger one (owner only).
+     *
+     * @return Buffer* New buffer.
+     */
+    auto _grow(Buffer *buffer, std::int64_t bottom, std::int64_t top)
+        -> Buffer *;
+};
+
+/**
+ * @brief Per worker slot of a STEAL queue.
+ *
+ */
+struct WorkerSlot {
+    TaskDeque        deque;
+    std::atomic_bool attached{false};
+};
+
+} // namespace nexus::exec::detail
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "nexus/common.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+
+namespace nexus::exec {
+
+class ThreadPool;
+
+} // namespace nexus::exec
+
+namespace nexus::exec::detail {
+
+/**
+ * @brief Counter of pending tasks a thread waits for, helping the pool
+ * meanwhile instead of parking. Shared by `TaskGroup` and parallel loops.
+ *
+ */
+class NEXUS_EXPORT HelpLatch {
+  public:
+    /**
+     * @brief Failed helping rounds before a worker of the pool blocks.
+     *
+     */
+    constexpr static std::size_t HELP_SPINS = 64;
+
+    /**
+     * @brief Max time a blocked worker of the pool sleeps before it tries to
+     * help again.
+     *
+     */
+    constexpr static auto HELP_PARK = std::chrono::milliseconds(1);
+
+    /**
+     * @brief Run one task of the waiter's own first, e.g. an unstarted child.
+     *
+     */
+    using OwnFn = std::function<bool()>;
+
+  private:
+    std::atomic_size_t      _pending;
+    std::mutex              _lock;
+    std::condition_variable _cond;
+
+  public:
+    explicit HelpLatch(std::size_t init = 0) : _pending(init) {}
+
+    /**
+     * @brief Add pending tasks, only by a pending task or the waiter.
+     *
+     */
+    NEXUS_INLINE auto add(std::size_t cnt = 1) -> void {
+        _pending.fetch_add(cnt, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Remove pending tasks which were never started.
+     *
+     */
+    NEXUS_INLINE auto cancel(std::size_t cnt = 1) -> void {
+        _pending.fetch_sub(cnt, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Mark a pending task done, the last one notifies the waiter under
+     * the lock.
+     *
+     */
+    auto done() -> void;
+
+    /**
+     * @brief Wait for all pending tasks. The waiter runs its own tasks first,
+     * then a worker of the pool runs queued tasks of the pool, a thread which
+     * is not one never runs unrelated tasks. Once there is nothing to run, a
+     * thread which is not a worker of the pool blocks, a worker of the pool
+     * retries `HELP_SPINS` times, then sleeps on the latch up to `HELP_PARK`
+     * between rounds. Blocking is safe, pending tasks are always queued on
+     * the pool.
+     *
+     * @param pool Thread pool running the tasks.
+     * @param own Own task runner, empty if none.
+     */
+    auto wait(ThreadPool &pool, const OwnFn &own = {}) -> void;
+};
+
+} // namespace nexus::exec::detail
@@ -0,0 +1,170 @@
+#pragma once
+
+#include "nexus/common.hpp"
+#include "nexus/exec/policy.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+namespace nexus::exec::detail {
+
+/**
+ * @brief Hint the cpu that the thread is spinning.
+ *
+ */
+NEXUS_INLINE auto cpu_relax() -> void {
+#if defined __x86_64__ || defined __i386__
+    __builtin_ia32_pause();
+#elif defined __aarch64__
+    asm volatile("yield" ::: "memory");
+#endif
+}
+
+/**
+ * @brief Idle strategy of a worker before it parks on the queue.
+ *
+ */
+class IdleBackoff {
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    constexpr static std::size_t   YIELD_CNT = 16;
+    constexpr static std::uint32_t EWMA_SHIFT = 3; /**< Weight 1/8. */
+
+    IdlePolicy  _policy;
+    std::size_t _max_spin;
+
+    /**
+     * @brief Current spin budget (Adaptive only), twice the average gap
+     * between tasks in spin iterations. It is 0 when the average gap is
+     * longer than `_max_spin` iterations, spinning would not catch the next
+     * task then.
+     *
+     */
+    std::size_t _spin;
+
+    std::uint64_t _gap_ns{0};  /**< EWMA of the idle gap before a task. */
+    std::uint64_t _spin_ns{0}; /**< EWMA of the cost of one spin. */
+
+    Clock::time_point _idle_since;
+    bool              _idle{false};
+
+  public:
+    IdleBackoff(IdlePolicy policy, std::size_t spin_count)
+        : _policy(policy), _max_spin(spin_count), _spin(spin_count) {}
+
+    /**
+     * @brief Get current spin budget.
+     *
+     * @return std::size_t Spin budget.
+     */
+    [[nodiscard]] NEXUS_INLINE auto spin_budget() const -> std::size_t {
+        return _spin;
+    }
+
+    /**
+     * @brief Wait for ready without parking.
+     *
+     * @param ready Ready pred, usually checks if queue is not empty.
+     * @return true Ready is satisfied.
+     * @return false Budget is exhausted, the caller should park.
+     */
+    template <typename F> auto wait(F &&ready) -> bool {
+        switch (_policy) {
+        case IdlePolicy::Spin:     return _spin_for(_max_spin, ready);
+        case IdlePolicy::Adaptive: return _adaptive(ready);
+        default:                   return false;
+        }
+    }
+
+    /**
+     * @brief Record that the worker got a task, after spinning or parking.
+     * The time since the queue went empty is one sample of the gap between
+     * tasks (Adaptive only).
+     *
+     */
+    NEXUS_INLINE auto resume() -> void {
+        if (!_idle) {
+            return;
+        }
+        _idle = false;
+
+        auto gap = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       Clock::now() - _idle_since)
+                       .count();
+        _gap_ns = _ewma(_gap_ns, static_cast<std::uint64_t>(std::max(
+                                     gap, decltype(gap)(0))));
+        _resize();
+    }
+
+  private:
+    NEXUS_INLINE static auto _ewma(std::uint64_t avg, std::uint64_t sample)
+        -> std::uint64_t {
+        if (avg == 0) {
+            return sample;
+        }
+        return avg - (avg >> EWMA_SHIFT) + (sample >> EWMA_SHIFT);
+    }
+
+    /**
+     * @brief Size the spin budget from the average gap.
+     *
+     */
+    auto _resize() -> void {
+        if (_spin_ns == 0) {
+            // Spin cost is unknown until one spin ran out, stay at the max.
+            return;
+        }
+
+        auto want = (2 * _gap_ns) / _spin_ns;
+        _spin = want > _max_spin ? 0 : static_cast<std::size_t>(want);
+    }
+
+    template <typename F>
+    static auto _spin_for(std::size_t cnt, F &ready) -> bool {
+        for (std::size_t i = 0; i < cnt; ++i) {
+            if (ready()) {
+                return true;
+            }
+            cpu_relax();
+        }
+
+        return ready();
+    }
+
+    template <typename F> auto _adaptive(F &ready) -> bool {
+        if (!_idle) {
+            _idle = true;
+            _idle_since = Clock::now();
+        }
+
+        if (_spin != 0) {
+            auto start = Clock::now();
+            if (_spin_for(_spin, ready)) {
+                return true;
+            }
+
+            // A full spin, sample its cost per iteration.
+            auto cost = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            Clock::now() - start)
+                            .count() /
+                        static_cast<std::int64_t>(_spin);
+            _spin_ns = _ewma(_spin_ns, static_cast<std::uint64_t>(
+                                           std::max(cost, std::int64_t(1))));
+        }
+
+        for (std::size_t i = 0; i < YIELD_CNT; ++i) {
+            std::this_thread::yield();
+            if (ready()) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+};
+
+} // namespace nexus::exec::detail
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "nexus/common.hpp"
+#include "nexus/exec/thread/metrics.hpp"
+#include "nexus/private/exec/queue.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace nexus::exec::detail {
+
+/**
+ * @brief Add to a counter written by one thread only, a relaxed load and
+ * store instead of a locked read-modify-write.
+ *
+ * @param cnt Counter.
+ * @param value Value to add.
+ */
+NEXUS_INLINE auto bump(std::atomic_uint64_t &cnt, std::uint64_t value = 1)
+    -> void {
+    cnt.store(cnt.load(std::memory_order_relaxed) + value,
+              std::memory_order_relaxed);
+}
+
+/**
+ * @brief Histogram written by one thread and read by others.
+ *
+ */
+class AtomicHistogram {
+  private:
+    std::array<std::atomic_uint64_t, Histogram::BUCKETS> _counts{};
+    std::atomic_uint64_t                                 _sum{0};
+    std::atomic_uint64_t                                 _min{UINT64_MAX};
+    std::atomic_uint64_t                                 _max{0};
+
+  public:
+    /**
+     * @brief Record a value (owner only).
+     *
+     * @param value Value.
+     */
+    NEXUS_INLINE auto record(std::uint64_t value) -> void {
+        bump(_counts[Histogram::bucket(value)]);
+        bump(_sum, value);
+        if (value < _min.load(std::memory_order_relaxed)) {
+            _min.store(value, std::memory_order_relaxed);
+        }
+        if (value > _max.load(std::memory_order_relaxed)) {
+            _max.store(value, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Add recorded values to a histogram (any thread), the result may
+     * miss values recorded meanwhile.
+     *
+     * @param out Output histogram.
+     */
+    auto load(Histogram &out) const -> void;
+};
+
+/**
+ * @brief Statistics of one worker, written by the worker only.
+ *
+ */
+struct alignas(CACHE_LINE_SIZE) WorkerStats {
+    std::atomic_uint64_t executed{0};
+    std::atomic_uint64_t steals{0};
+    std::atomic_uint64_t parks{0};
+    std::atomic_uint64_t misses{0};
+    std::atomic_uint64_t late{0};
+    AtomicHistogram      wait;
+    AtomicHistogram      run;
+};
+
+/**
+ * @brief Get statistics of the worker running on calling thread, queues use it
+ * to count steals and parks.
+ *
+ * @return WorkerStats*& Statistics, nullptr if thread is not a worker.
+ */
+NEXUS_EXPORT auto current_stats() -> WorkerStats *&;
+
+} // namespace nexus::exec::detail
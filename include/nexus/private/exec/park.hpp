@@ -0,0 +1,144 @@
+#pragma once
+
+#include "nexus/common.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+
+namespace nexus::exec::detail {
+
+/**
+ * @brief Parking slot of one waiting thread, a thread is only woken up
+ * through its own slot.
+ *
+ */
+struct Parker {
+    std::condition_variable cond;
+    Parker                 *prev{nullptr};
+    Parker                 *next{nullptr};
+    bool                    linked{false};
+    bool                    notified{false};
+
+    /**
+     * @brief Mirror of `linked` readable without the lock.
+     *
+     */
+    std::atomic_bool parked{false};
+};
+
+/**
+ * @brief Intrusive list of parked threads, guarded by the lock of the owner.
+ *
+ * @note The most recently parked thread is woken up first, its cache is most
+ * likely still warm and long idle threads stay asleep.
+ */
+class ParkingLot {
+  private:
+    Parker            *_head{nullptr};
+    std::atomic_size_t _size{0};
+
+  public:
+    ParkingLot() = default;
+    ~ParkingLot() = default;
+
+    ParkingLot(const ParkingLot &other) = delete;
+    auto operator=(const ParkingLot &other) -> ParkingLot & = delete;
+
+    ParkingLot(ParkingLot &&other) = delete;
+    auto operator=(ParkingLot &&other) -> ParkingLot & = delete;
+
+    /**
+     * @brief Get parked count, may be read without the lock.
+     *
+     * @return std::size_t Parked count.
+     */
+    [[nodiscard]] NEXUS_INLINE auto size() const -> std::size_t {
+        return _size.load();
+    }
+
+    /**
+     * @brief Link a parker.
+     *
+     * @param parker Parker to link.
+     */
+    NEXUS_INLINE auto link(Parker &parker) -> void {
+        parker.prev = nullptr;
+        parker.next = _head;
+        if (_head != nullptr) {
+            _head->prev = &parker;
+        }
+        _head = &parker;
+        parker.linked = true;
+        parker.parked.store(true, std::memory_order_relaxed);
+        parker.notified = false;
+
+        // Pairs with the size check of lock free pushers.
+        _size.fetch_add(1);
+    }
+
+    /**
+     * @brief Unlink a parker, no-op if it is not linked.
+     *
+     * @param parker Parker to unlink.
+     */
+    NEXUS_INLINE auto unlink(Parker &parker) -> void {
+        if (!parker.linked) {
+            return;
+        }
+
+        if (parker.prev != nullptr) {
+            parker.prev->next = parker.next;
+        } else {
+            _head = parker.next;
+        }
+        if (parker.next != nullptr) {
+            parker.next->prev = parker.prev;
+        }
+
+        parker.prev = nullptr;
+        parker.next = nullptr;
+        parker.linked = false;
+        parker.parked.store(false, std::memory_order_relaxed);
+        _size.fetch_sub(1);
+    }
+
+    /**
+     * @brief Wake up a parker, no-op if it is not linked.
+     *
+     * @param parker Parker to wake up.
+     * @return true Parker is woken up.
+     * @return false Parker is not parked.
+     */
+    NEXUS_INLINE auto unpark(Parker &parker) -> bool {
+        if (!parker.linked) {
+            return false;
+        }
+
+        unlink(parker);
+        parker.notified = true;
+
+        // Notified under the lock, the parker may live on the stack of the
+        // waiting thread.
+        parker.cond.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Wake up at most `cnt` parkers.
+     *
+     * @param cnt Max parkers to wake up.
+     * @return std::size_t Parkers woken up.
+     */
+    NEXUS_INLINE auto unpark(std::size_t cnt) -> std::size_t {
+        std::size_t woken = 0;
+        while (_head != nullptr && woken < cnt) {
+            unpark(*_head);
+            ++woken;
+        }
+
+        return woken;
+    }
+};
+
+} // namespace nexus::exec::detail
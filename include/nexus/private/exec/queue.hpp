@@ -3,9 +3,27 @@
 #include "nexus/exec/task.hpp"
 
 #include <cstddef>
+#include <memory>
+#include <optional>
+#include <utility>
 
 namespace nexus::exec::detail {
 
+/**
+ * @brief Cache line size used to separate hot atomics.
+ *
+ */
+constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+/**
+ * @brief Options passed to queue creators.
+ *
+ */
+struct TaskQueueConfig {
+    std::size_t workers;  /**< Max workers of the queue. */
+    std::size_t capacity; /**< Capacity of bounded queues. */
+};
+
 /**
  * @brief Task queue implementation.
  *
@@ -41,34 +59,97 @@ class TaskQueueInner {
      * @return std::size_t Queue size.
      */
     virtual auto size() -> std::size_t = 0;
+
+    /**
+     * @brief Get if queue synchronizes itself (lock free, or with its own
+     * locks), `TaskQueue` calls `try_push` and `try_pop` without holding its
+     * lock then.
+     *
+     * @return true Queue synchronizes itself.
+     * @return false Queue must be guarded by `TaskQueue`.
+     */
+    [[nodiscard]] virtual auto self_synchronized() const -> bool {
+        return false;
+    }
+
+    /**
+     * @brief Try to push task into queue.
+     *
+     * @param task Task object, untouched if queue is full.
+     * @return true Task is pushed.
+     * @return false Queue is full.
+     */
+    virtual auto try_push(Task<> &&task) -> bool {
+        push(std::move(task));
+        return true;
+    }
+
+    /**
+     * @brief Try to pop task from queue.
+     *
+     * @return std::optional<Task<>> Task object, empty if queue is empty.
+     */
+    virtual auto try_pop() -> std::optional<Task<>> {
+        if (size() == 0) {
+            return {};
+        }
+
+        return pop();
+    }
 };
 
 /**
  * @brief Create FIFO queue.
  *
+ * @param cfg Queue options.
  * @return std::unique_ptr<TaskQueueInner> Queue pointer.
  */
-auto _make_fifo_queue() -> std::unique_ptr<TaskQueueInner>;
+auto _make_fifo_queue(const TaskQueueConfig &cfg)
+    -> std::unique_ptr<TaskQueueInner>;
 
 /**
  * @brief Create LIFO queue.
  *
+ * @param cfg Queue options.
  * @return std::unique_ptr<TaskQueueInner> Queue pointer.
  */
-auto _make_lifo_queue() -> std::unique_ptr<TaskQueueInner>;
+auto _make_lifo_queue(const TaskQueueConfig &cfg)
+    -> std::unique_ptr<TaskQueueInner>;
 
 /**
  * @brief Create PRIO queue.
  *
+ * @param cfg Queue options.
  * @return std::unique_ptr<TaskQueueInner> Queue pointer.
  */
-auto _make_prio_queue() -> std::unique_ptr<TaskQueueInner>;
+auto _make_prio_queue(const TaskQueueConfig &cfg)
+    -> std::unique_ptr<TaskQueueInner>;
 
 /**
  * @brief Create RAND queue.
  *
+ * @param cfg Queue options.
+ * @return std::unique_ptr<TaskQueueInner> Queue pointer.
+ */
+auto _make_rand_queue(const TaskQueueConfig &cfg)
+    -> std::unique_ptr<TaskQueueInner>;
+
+/**
+ * @brief Create RING queue.
+ *
+ * @param cfg Queue options.
+ * @return std::unique_ptr<TaskQueueInner> Queue pointer.
+ */
+auto _make_ring_queue(const TaskQueueConfig &cfg)
+    -> std::unique_ptr<TaskQueueInner>;
+
+/**
+ * @brief Create EDF queue.
+ *
+ * @param cfg Queue options.
  * @return std::unique_ptr<TaskQueueInner> Queue pointer.
  */
-auto _make_rand_queue() -> std::unique_ptr<TaskQueueInner>;
+auto _make_edf_queue(const TaskQueueConfig &cfg)
+    -> std::unique_ptr<TaskQueueInner>;
 
 } // namespace nexus::exec::detail
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "nexus/common.hpp"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace nexus::exec::detail {
+
+/**
+ * @brief Small and fast random generator (xoshiro128**), used for victim and
+ * queue selection where statistical quality matters less than speed.
+ *
+ */
+class FastRandom {
+  private:
+    std::array<std::uint32_t, 4> _state{};
+
+  public:
+    /**
+     * @brief Construct generator, the state is expanded from seed with
+     * splitmix64.
+     *
+     * @param seed Seed.
+     */
+    explicit FastRandom(std::uint64_t seed) {
+        for (std::size_t i = 0; i < _state.size(); i += 2) {
+            seed += 0x9e3779b97f4a7c15ULL;
+            auto mix = seed;
+            mix = (mix ^ (mix >> 30U)) * 0xbf58476d1ce4e5b9ULL;
+            mix = (mix ^ (mix >> 27U)) * 0x94d049bb133111ebULL;
+            mix ^= mix >> 31U;
+
+            _state[i] = static_cast<std::uint32_t>(mix);
+            _state[i + 1] = static_cast<std::uint32_t>(mix >> 32U);
+        }
+    }
+
+    /**
+     * @brief Get next random number.
+     *
+     * @return std::uint32_t Random number.
+     */
+    NEXUS_INLINE auto operator()() -> std::uint32_t {
+        auto res = std::rotl(_state[1] * 5U, 7) * 9U;
+        auto tmp = _state[1] << 9U;
+
+        _state[2] ^= _state[0];
+        _state[3] ^= _state[1];
+        _state[1] ^= _state[2];
+        _state[0] ^= _state[3];
+        _state[2] ^= tmp;
+        _state[3] = std::rotl(_state[3], 11);
+
+        return res;
+    }
+
+    /**
+     * @brief Get next random number in `[0, bound)`.
+     *
+     * @param bound Upper bound, should not be 0.
+     * @return std::uint32_t Random number.
+     */
+    NEXUS_INLINE auto bounded(std::uint32_t bound) -> std::uint32_t {
+        // Multiply-shift instead of modulo, bias is negligible here.
+        return static_cast<std::uint32_t>(
+            (static_cast<std::uint64_t>((*this)()) * bound) >> 32U);
+    }
+};
+
+/**
+ * @brief Get random generator of calling thread, seeded per thread.
+ *
+ * @return FastRandom& Random generator.
+ */
+NEXUS_EXPORT auto thread_random() -> FastRandom &;
+
+} // namespace nexus::exec::detail
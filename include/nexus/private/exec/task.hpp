@@ -1,12 +1,180 @@
 #pragma once
 
+#include "nexus/common.hpp"
+#include "nexus/config.hpp"
+
+#include <cstddef>
 #include <future>
+#include <new>
 #include <tuple>
 #include <type_traits>
 #include <utility>
 
 namespace nexus::exec::detail {
 
+/**
+ * @brief Move only type erased function with inline storage, callables that
+ * fit in `Size` bytes are stored without heap allocation.
+ *
+ * @tparam Sig Function signature.
+ * @tparam Size Inline storage size.
+ */
+template <typename Sig, std::size_t Size = NEXUS_EXEC_TASK_INLINE_SIZE>
+class TaskFunction;
+
+template <typename R, typename... Args, std::size_t Size>
+class TaskFunction<R(Args...), Size> {
+    static_assert(Size >= sizeof(void *),
+                  "Inline storage must be able to hold a pointer");
+
+  private:
+    /**
+     * @brief Operations of stored callable.
+     *
+     */
+    struct VTable {
+        R (*call)(void *storage, Args... args);
+        void (*move)(void *dst, void *src) noexcept;
+        void (*destroy)(void *storage) noexcept;
+    };
+
+    /**
+     * @brief Check if callable can be stored inline.
+     *
+     * @tparam F Callable type.
+     */
+    template <typename F>
+    constexpr static bool IS_INLINE =
+        sizeof(F) <= Size && alignof(F) <= alignof(std::max_align_t) &&
+        std::is_nothrow_move_constructible_v<F>;
+
+    /**
+     * @brief Operations of inline callable.
+     *
+     * @tparam F Callable type.
+     */
+    template <typename F> struct InlineOps {
+        static auto get(void *storage) -> F * {
+            return std::launder(static_cast<F *>(storage));
+        }
+
+        static auto call(void *storage, Args... args) -> R {
+            return (*get(storage))(std::forward<Args>(args)...);
+        }
+
+        static auto move(void *dst, void *src) noexcept -> void {
+            ::new (dst) F(std::move(*get(src)));
+            get(src)->~F();
+        }
+
+        static auto destroy(void *storage) noexcept -> void {
+            get(storage)->~F();
+        }
+
+        constexpr static VTable VTABLE = {call, move, destroy};
+    };
+
+    /**
+     * @brief Operations of heap callable, storage holds the pointer.
+     *
+     * @tparam F Callable type.
+     */
+    template <typename F> struct HeapOps {
+        static auto get(void *storage) -> F *& {
+            return *std::launder(static_cast<F **>(storage));
+        }
+
+        static auto call(void *storage, Args... args) -> R {
+            return (*get(storage))(std::forward<Args>(args)...);
+        }
+
+        static auto move(void *dst, void *src) noexcept -> void {
+            ::new (dst) F *(get(src));
+        }
+
+        static auto destroy(void *storage) noexcept -> void {
+            delete get(storage);
+        }
+
+        constexpr static VTable VTABLE = {call, move, destroy};
+    };
+
+    alignas(std::max_align_t) std::byte _storage[Size]; // NOLINT
+    const VTable *_vtable{nullptr};
+
+  public:
+    TaskFunction() = default;
+
+    /**
+     * @brief Construct from callable.
+     *
+     * @tparam F Callable type.
+     * @param func Callable.
+     */
+    template <typename F>
+        requires(!std::is_same_v<std::decay_t<F>, TaskFunction> &&
+                 std::is_invocable_r_v<R, std::decay_t<F> &, Args...>)
+    TaskFunction(F &&func) { // NOLINT
+        using Callable = std::decay_t<F>;
+
+        if constexpr (IS_INLINE<Callable>) {
+            ::new (static_cast<void *>(_storage))
+                Callable(std::forward<F>(func));
+            _vtable = &InlineOps<Callable>::VTABLE;
+        } else {
+            ::new (static_cast<void *>(_storage))
+                Callable *(new Callable(std::forward<F>(func)));
+            _vtable = &HeapOps<Callable>::VTABLE;
+        }
+    }
+
+    ~TaskFunction() { _reset(); }
+
+    TaskFunction(const TaskFunction &other) = delete;
+    auto operator=(const TaskFunction &other) -> TaskFunction & = delete;
+
+    TaskFunction(TaskFunction &&other) noexcept : _vtable(other._vtable) {
+        if (_vtable != nullptr) {
+            _vtable->move(_storage, other._storage);
+            other._vtable = nullptr;
+        }
+    }
+
+    auto operator=(TaskFunction &&other) noexcept -> TaskFunction & {
+        if (this != &other) {
+            _reset();
+            _vtable = other._vtable;
+            if (_vtable != nullptr) {
+                _vtable->move(_storage, other._storage);
+                other._vtable = nullptr;
+            }
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Call stored callable.
+     *
+     */
+    NEXUS_INLINE auto operator()(Args... args) -> R {
+        return _vtable->call(_storage, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Check if a callable is stored.
+     *
+     */
+    NEXUS_INLINE explicit operator bool() const { return _vtable != nullptr; }
+
+  private:
+    NEXUS_INLINE auto _reset() -> void {
+        if (_vtable != nullptr) {
+            _vtable->destroy(_storage);
+            _vtable = nullptr;
+        }
+    }
+};
+
 /**
  * @brief Task function binder.
  *
@@ -15,8 +183,8 @@ namespace nexus::exec::detail {
  * @tparam Args Function arguments type.
  */
 template <typename F, typename R, typename... Args>
-    requires(std::is_invocable_v<F, Args...> &&
-             std::is_convertible_v<std::invoke_result_t<F, Args...>, R>)
+    requires(std::is_invocable_v<F &, Args &...> &&
+             std::is_convertible_v<std::invoke_result_t<F &, Args &...>, R>)
 class TaskBinder {
   public:
     /**
@@ -29,7 +197,7 @@ class TaskBinder {
      * @brief Inner return type.
      *
      */
-    using Result = std::invoke_result_t<F, Args...>;
+    using Result = std::invoke_result_t<F &, Args &...>;
 
     /**
      * @brief Arguments tuple type.
@@ -42,36 +210,55 @@ class TaskBinder {
     ArgsTuple _args;
 
   public:
-    explicit constexpr TaskBinder(const F &func, Args &&...args)
-        : _func(func), _args(std::forward<Args>(args)...) {}
+    template <typename Fn, typename... As>
+        requires(std::is_constructible_v<F, Fn> &&
+                 sizeof...(As) == sizeof...(Args))
+    explicit constexpr TaskBinder(Fn &&func, As &&...args)
+        : _func(std::forward<Fn>(func)), _args(std::forward<As>(args)...) {}
 
-    explicit constexpr TaskBinder(F &&func, Args &&...args)
-        : _func(std::move(func)), _args(std::forward<Args>(args)...) {}
+    auto operator()(std::promise<WrappedResult> *res) -> void {
+        _call(*this, res);
+    }
 
-    auto operator()(std::promise<WrappedResult> &res) -> void {
-        static_cast<const TaskBinder *>(this)->operator()(res);
+    auto operator()(std::promise<WrappedResult> *res) const -> void {
+        _call(*this, res);
     }
 
+  private:
     /**
      * @brief Wrapped function body.
      *
-     * @param res Promise to pass return value.
+     * @param self Binder object.
+     * @param res Promise to pass return value, nullptr for detached task,
+     * error is thrown to the caller then.
      */
-    auto operator()(std::promise<WrappedResult> &res) const -> void {
+    template <typename Self>
+    static auto _call(Self &self, std::promise<WrappedResult> *res) -> void {
+        if (res == nullptr) {
+            std::apply(self._func, self._args);
+            return;
+        }
+
         try {
             if constexpr (std::is_same_v<WrappedResult, void>) {
-                std::apply(_func, _args);
-                res.set_value();
+                std::apply(self._func, self._args);
+                res->set_value();
             } else {
-                res.set_value(
-                    static_cast<WrappedResult>(std::apply(_func, _args)));
+                res->set_value(static_cast<WrappedResult>(
+                    std::apply(self._func, self._args)));
             }
         } catch (...) {
-            res.set_exception(std::current_exception());
+            res->set_exception(std::current_exception());
         }
     }
 };
 
+/**
+ * @brief Tag to construct a task without result channel.
+ *
+ */
+struct TaskDetach {};
+
 /**
  * @brief Task helper to wrap function.
  *
@@ -100,4 +287,15 @@ template <typename F, typename R, typename... Args> struct TaskHelper {
     using Binder = TaskBinder<Function, Result, std::decay_t<Args>...>;
 };
 
+/**
+ * @brief Decayed result type of function, called the way `TaskBinder` calls
+ * it: a non-const function with its stored arguments as lvalues.
+ *
+ * @tparam F Function type.
+ * @tparam Args Function arguments type.
+ */
+template <typename F, typename... Args>
+using TaskResult = std::decay_t<
+    std::invoke_result_t<std::decay_t<F> &, std::decay_t<Args> &...>>;
+
 } // namespace nexus::exec::detail
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "nexus/common.hpp"
+
+#include <cstddef>
+#include <functional>
+
+#ifdef __linux__
+    #include <pthread.h>
+#else
+    #include <thread>
+#endif
+
+namespace nexus::exec::detail {
+
+/**
+ * @brief Joining thread with a configurable stack size, which `std::jthread`
+ * can not provide.
+ *
+ */
+class NEXUS_EXPORT NativeThread {
+  public:
+    /**
+     * @brief Thread entry type.
+     *
+     */
+    using Function = std::function<void()>;
+
+  private:
+#ifdef __linux__
+    pthread_t _handle{};
+#else
+    std::thread _thread;
+#endif
+
+  public:
+    /**
+     * @brief Start a thread.
+     *
+     * @param stack_size Stack size in bytes, 0 for the system default.
+     * @param func Thread entry.
+     *
+     * @throw std::system_error Thread can not be created.
+     */
+    NativeThread(std::size_t stack_size, Function func);
+
+    /**
+     * @brief Join the thread.
+     *
+     */
+    ~NativeThread();
+
+    NativeThread(const NativeThread &other) = delete;
+    auto operator=(const NativeThread &other) -> NativeThread & = delete;
+
+    NativeThread(NativeThread &&other) = delete;
+    auto operator=(NativeThread &&other) -> NativeThread & = delete;
+};
+
+} // namespace nexus::exec::detail
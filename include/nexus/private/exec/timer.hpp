@@ -0,0 +1,217 @@
+#pragma once
+
+#include "nexus/common.hpp"
+#include "nexus/exec/thread/timer.hpp"
+#include "nexus/private/exec/task.hpp"
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+namespace nexus::exec {
+
+class ThreadPool;
+
+} // namespace nexus::exec
+
+namespace nexus::exec::detail {
+
+/**
+ * @brief Hierarchical timing wheel, one thread advances it and posts expired
+ * timers to the pool.
+ *
+ * Level `l` has `SLOTS` slots of `SLOTS^l` ticks each, a timer sits in the
+ * lowest level whose span covers its remaining ticks and moves down a level
+ * when the wheel reaches its slot. Insert and cancel are O(1), each timer
+ * cascades at most `LEVELS - 1` times.
+ *
+ * @note Timers never fire early, and fire at most one tick late plus the
+ * queueing delay of the pool.
+ */
+class TimerWheel {
+  public:
+    using Clock = std::chrono::steady_clock;
+    using Function = TaskFunction<void()>;
+
+    constexpr static auto        TICK = std::chrono::milliseconds(1);
+    constexpr static std::size_t SLOT_BITS = 8;
+    constexpr static std::size_t SLOTS = std::size_t(1) << SLOT_BITS;
+    constexpr static std::size_t LEVELS = 4;
+
+    /**
+     * @brief Ticks covered by the wheel, later timers are parked in the last
+     * slot of the top level and placed again when it cascades.
+     *
+     */
+    constexpr static std::uint64_t RANGE = std::uint64_t(1)
+                                           << (SLOT_BITS * LEVELS);
+
+  private:
+    constexpr static std::uint32_t NIL = UINT32_MAX;
+
+    enum class State : std::uint8_t {
+        FREE,    /**< In the free list. */
+        PENDING, /**< Linked in a slot. */
+        RUNNING, /**< Posted to the pool. */
+    };
+
+    /**
+     * @brief Timer entry, linked into a slot by index.
+     *
+     */
+    struct Entry {
+        Function          func;
+        Clock::time_point deadline;
+        Clock::duration   period{0};
+        std::uint64_t     expiry{0};
+        std::uint32_t     prev{NIL};
+        std::uint32_t     next{NIL};
+        std::uint32_t     slot{0};
+        std::uint32_t     id{0};
+        std::uint32_t     gen{0};
+        State             state{State::FREE};
+        bool              cancelled{false};
+    };
+
+    ThreadPool *_pool;
+
+    /**
+     * @brief Entries never move, a running timer is called without the lock.
+     *
+     */
+    std::deque<Entry>                         _entries;
+    std::vector<std::uint32_t>                _free;
+    std::array<std::uint32_t, LEVELS * SLOTS> _slots{};
+
+    Clock::time_point _origin{Clock::now()};
+    std::uint64_t     _now{0};
+    std::uint64_t     _wake{UINT64_MAX};
+    std::size_t       _pending{0};
+    bool              _stopped{false};
+
+    std::mutex                  _lock;
+    std::condition_variable_any _cond;
+    std::jthread                _thread;
+
+  public:
+    explicit TimerWheel(ThreadPool *pool);
+    ~TimerWheel();
+
+    TimerWheel(const TimerWheel &other) = delete;
+    auto operator=(const TimerWheel &other) -> TimerWheel & = delete;
+
+    TimerWheel(TimerWheel &&other) = delete;
+    auto operator=(TimerWheel &&other) -> TimerWheel & = delete;
+
+    /**
+     * @brief Add a timer, the timer thread starts with the first one.
+     *
+     * @param deadline First run time.
+     * @param period Period, zero for a one-shot timer.
+     * @param func Function.
+     * @return TimerHandle Handle to cancel the timer.
+     */
+    auto add(Clock::time_point deadline, Clock::duration period,
+             Function &&func) -> TimerHandle;
+
+    /**
+     * @brief Cancel a timer.
+     *
+     * @param id Entry index.
+     * @param gen Entry generation, stale handles are ignored.
+     * @return bool Whether the timer will not run again.
+     */
+    auto cancel(std::uint32_t id, std::uint32_t gen) -> bool;
+
+    /**
+     * @brief Stop the timer thread, pending timers never fire.
+     *
+     */
+    auto stop() -> void;
+
+    /**
+     * @brief Get count of pending timers.
+     *
+     * @return std::size_t Pending timers.
+     */
+    [[nodiscard]] auto size() -> std::size_t;
+
+  private:
+    auto _loop(const std::stop_token &stop) -> void;
+
+    /**
+     * @brief Advance one tick, cascade upper levels and collect expired
+     * entries.
+     *
+     * @param expired Expired entries.
+     */
+    auto _advance(std::vector<Entry *> &expired) -> void;
+
+    /**
+     * @brief Get the next tick the thread should wake up at, the first
+     * occupied slot of level 0 before the next cascade.
+     *
+     */
+    [[nodiscard]] auto _next_tick() const -> std::uint64_t;
+
+    /**
+     * @brief Link a pending entry into its slot.
+     *
+     * @param id Entry index.
+     * @return bool False if the entry is already due.
+     */
+    auto _link(std::uint32_t id) -> bool;
+
+    auto _unlink(std::uint32_t id) -> void;
+
+    /**
+     * @brief Place an entry after it is created or re-armed, it is posted at
+     * once if due.
+     *
+     * @param guard Held lock, released if the entry is posted.
+     * @param id Entry index.
+     */
+    auto _arm(std::unique_lock<std::mutex> &guard, std::uint32_t id) -> void;
+
+    /**
+     * @brief Mark entries running and post them, the lock is released.
+     *
+     * @param guard Held lock.
+     * @param expired Expired entries, cleared.
+     */
+    auto _post(std::unique_lock<std::mutex> &guard,
+               std::vector<Entry *> &expired) -> void;
+
+    /**
+     * @brief Run an entry on a worker, then free or re-arm it.
+     *
+     * @param entry Entry, the pointer is taken under the lock.
+     */
+    auto _run(Entry *entry) -> void;
+
+    auto _alloc() -> std::uint32_t;
+    auto _release(std::uint32_t id) -> void;
+
+    /**
+     * @brief Convert a time point to a tick, rounding up.
+     *
+     */
+    [[nodiscard]] auto _ceil_tick(Clock::time_point tp) const
+        -> std::uint64_t;
+
+    /**
+     * @brief Convert a time point to a tick, rounding down.
+     *
+     */
+    [[nodiscard]] auto _floor_tick(Clock::time_point tp) const
+        -> std::uint64_t;
+};
+
+} // namespace nexus::exec::detail
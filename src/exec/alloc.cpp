@@ -0,0 +1,242 @@
+#include "nexus/private/exec/alloc.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+
+namespace nexus::exec::detail {
+
+namespace {
+
+constexpr std::size_t MIN_BLOCK_SHIFT = 5;
+constexpr std::size_t CLASS_CNT = 4; // 32, 64, 128, 256 bytes.
+constexpr std::size_t MAX_BLOCK_SIZE = (1ULL << MIN_BLOCK_SHIFT)
+                                       << (CLASS_CNT - 1);
+
+constexpr std::size_t CHUNK_BLOCKS = 64;
+constexpr std::size_t CACHE_LIMIT = 256;
+constexpr std::size_t BATCH_BLOCKS = 64;
+
+/**
+ * @brief Free block, linked in place.
+ *
+ */
+struct FreeBlock {
+    FreeBlock *next;
+};
+
+/**
+ * @brief Free list of one size class.
+ *
+ */
+struct FreeList {
+    FreeBlock  *head{nullptr};
+    std::size_t count{0};
+
+    NEXUS_INLINE auto push(FreeBlock *block) -> void {
+        block->next = head;
+        head = block;
+        ++count;
+    }
+
+    NEXUS_INLINE auto pop() -> FreeBlock * {
+        auto *block = head;
+        head = block->next;
+        --count;
+        return block;
+    }
+};
+
+/**
+ * @brief Shared blocks, filled by thread caches and new chunks.
+ *
+ * @note Chunks are never returned to the system, the pool lives until the
+ * process exits.
+ */
+struct GlobalPool {
+    std::mutex                      lock;
+    std::array<FreeList, CLASS_CNT> lists;
+};
+
+auto global_pool() -> GlobalPool & {
+    static auto *pool = new GlobalPool(); // NOLINT
+    return *pool;
+}
+
+/**
+ * @brief Move up to `cnt` blocks between free lists.
+ *
+ */
+auto move_blocks(FreeList &from, FreeList &to, std::size_t cnt) -> void {
+    while (from.head != nullptr && cnt-- != 0) {
+        to.push(from.pop());
+    }
+}
+
+/**
+ * @brief Life state of the thread local cache of calling thread.
+ *
+ */
+enum class CacheState : std::uint8_t {
+    Unused, /**< Not constructed yet. */
+    Alive,  /**< Usable. */
+    Dead,   /**< Destroyed at thread exit, the global pool is used then. */
+};
+
+// Trivial, so it is still readable after the cache is destroyed.
+thread_local CacheState tls_cache_state = CacheState::Unused;
+
+/**
+ * @brief Thread local cache, blocks are returned to the global pool when the
+ * thread exits.
+ *
+ */
+struct LocalCache {
+    std::array<FreeList, CLASS_CNT> lists;
+
+    LocalCache() { tls_cache_state = CacheState::Alive; }
+
+    ~LocalCache() {
+        tls_cache_state = CacheState::Dead;
+
+        auto &pool = global_pool();
+        auto  guard = std::lock_guard(pool.lock);
+        for (std::size_t cls = 0; cls < CLASS_CNT; ++cls) {
+            move_blocks(lists[cls], pool.lists[cls], lists[cls].count);
+        }
+    }
+
+    LocalCache(const LocalCache &other) = delete;
+    auto operator=(const LocalCache &other) -> LocalCache & = delete;
+
+    LocalCache(LocalCache &&other) = delete;
+    auto operator=(LocalCache &&other) -> LocalCache & = delete;
+};
+
+thread_local LocalCache tls_cache;
+
+/**
+ * @brief Get free list of calling thread. Blocks may still be freed after the
+ * cache is destroyed, e.g. tasks left in a static pool at exit.
+ *
+ * @return FreeList* Free list, nullptr if the cache is already destroyed.
+ */
+NEXUS_INLINE auto local_list(std::size_t cls) -> FreeList * {
+    if (tls_cache_state == CacheState::Dead) {
+        return nullptr;
+    }
+    return &tls_cache.lists[cls];
+}
+
+/**
+ * @brief Get size class of block.
+ *
+ * @return std::size_t Size class index.
+ */
+NEXUS_INLINE auto size_class(std::size_t size) -> std::size_t {
+    std::size_t cls = 0;
+    while ((1ULL << (MIN_BLOCK_SHIFT + cls)) < size) {
+        ++cls;
+    }
+    return cls;
+}
+
+/**
+ * @brief Split a new chunk into blocks of a size class.
+ *
+ */
+auto carve_chunk(FreeList &list, std::size_t cls) -> void {
+    auto  block_size = 1ULL << (MIN_BLOCK_SHIFT + cls);
+    auto *chunk = static_cast<std::byte *>(
+        ::operator new(block_size * CHUNK_BLOCKS));
+    for (std::size_t i = 0; i < CHUNK_BLOCKS; ++i) {
+        list.push(reinterpret_cast<FreeBlock *>( // NOLINT
+            chunk + (i * block_size)));          // NOLINT
+    }
+}
+
+/**
+ * @brief Refill local list from global pool or a new chunk.
+ *
+ */
+auto refill(FreeList &local, std::size_t cls) -> void {
+    auto &pool = global_pool();
+    auto  guard = std::lock_guard(pool.lock);
+
+    move_blocks(pool.lists[cls], local, BATCH_BLOCKS);
+    if (local.head == nullptr) {
+        carve_chunk(local, cls);
+    }
+}
+
+/**
+ * @brief Take a block from the global pool, for threads without cache.
+ *
+ */
+auto global_allocate(std::size_t cls) -> void * {
+    auto &pool = global_pool();
+    auto  guard = std::lock_guard(pool.lock);
+
+    if (pool.lists[cls].head == nullptr) {
+        carve_chunk(pool.lists[cls], cls);
+    }
+    return pool.lists[cls].pop();
+}
+
+/**
+ * @brief Return a block to the global pool, for threads without cache.
+ *
+ */
+auto global_deallocate(FreeBlock *block, std::size_t cls) -> void {
+    auto &pool = global_pool();
+    auto  guard = std::lock_guard(pool.lock);
+
+    pool.lists[cls].push(block);
+}
+
+} // namespace
+
+auto pool_allocate(std::size_t size) -> void * {
+    if (size > MAX_BLOCK_SIZE) {
+        return ::operator new(size);
+    }
+
+    auto  cls = size_class(size);
+    auto *local = local_list(cls);
+    if (local == nullptr) {
+        return global_allocate(cls);
+    }
+
+    if (local->head == nullptr) {
+        refill(*local, cls);
+    }
+
+    return local->pop();
+}
+
+auto pool_deallocate(void *ptr, std::size_t size) -> void {
+    if (size > MAX_BLOCK_SIZE) {
+        ::operator delete(ptr);
+        return;
+    }
+
+    auto  cls = size_class(size);
+    auto *local = local_list(cls);
+    if (local == nullptr) {
+        global_deallocate(static_cast<FreeBlock *>(ptr), cls);
+        return;
+    }
+
+    local->push(static_cast<FreeBlock *>(ptr));
+
+    // Blocks freed by consumer threads flow back to producer threads.
+    if (local->count > CACHE_LIMIT) {
+        auto &pool = global_pool();
+        auto  guard = std::lock_guard(pool.lock);
+        move_blocks(*local, pool.lists[cls], BATCH_BLOCKS);
+    }
+}
+
+} // namespace nexus::exec::detail
@@ -0,0 +1,81 @@
+#include "nexus/private/exec/bucket.hpp"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace nexus::exec::detail {
+
+auto TaskRing::push(Task<> &&task) -> void {
+    if (_size == _slots.size()) {
+        _grow();
+    }
+
+    _slots[(_head + _size) & (_slots.size() - 1)].emplace(std::move(task));
+    ++_size;
+}
+
+auto TaskRing::pop() -> Task<> {
+    auto &slot = _slots[_head];
+    auto  task = std::move(slot.value());
+    slot.reset();
+
+    _head = (_head + 1) & (_slots.size() - 1);
+    --_size;
+
+    return task;
+}
+
+auto TaskRing::_grow() -> void {
+    auto next = std::vector<std::optional<Task<>>>(
+        _slots.empty() ? INIT_CAPACITY : _slots.size() * 2);
+
+    for (std::size_t i = 0; i < _size; ++i) {
+        auto &slot = _slots[(_head + i) & (_slots.size() - 1)];
+        next[i].emplace(std::move(slot.value()));
+    }
+
+    _slots = std::move(next);
+    _head = 0;
+}
+
+auto TaskBucketQueue::push(Task<> &&task) -> void {
+    auto level = _level(task.prio());
+
+    _buckets[level].push(std::move(task));
+
+    auto bit = std::uint64_t{1} << (level % WORD_BITS);
+    _bitmap[level / WORD_BITS] |= bit;
+    ++_size;
+}
+
+auto TaskBucketQueue::pop() -> Task<> {
+    auto  level = _top_level();
+    auto &bucket = _buckets[level];
+
+    auto task = bucket.pop();
+    if (bucket.empty()) {
+        auto bit = std::uint64_t{1} << (level % WORD_BITS);
+        _bitmap[level / WORD_BITS] &= ~bit;
+    }
+    --_size;
+
+    return task;
+}
+
+auto TaskBucketQueue::_top_level() const -> std::size_t {
+    for (auto word = WORDS; word > 0; --word) {
+        auto bits = _bitmap[word - 1];
+        if (bits != 0) {
+            return ((word - 1) * WORD_BITS) + (WORD_BITS - 1) -
+                   std::countl_zero(bits);
+        }
+    }
+
+    return 0;
+}
+
+} // namespace nexus::exec::detail
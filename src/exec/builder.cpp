@@ -1,8 +1,10 @@
 #include "nexus/exec/thread/builder.hpp"
+#include "nexus/exec/thread/numa.hpp"
 #include "nexus/exec/thread/pool.hpp"
 
 #include <cstddef>
 #include <thread>
+#include <utility>
 
 namespace nexus::exec::thread_builder {
 
@@ -55,4 +57,19 @@ auto time_bound() -> ThreadPool::Builder {
     return blank().max_workers(ncons / 2).init_workers(ncons / 2);
 }
 
+auto numa() -> ThreadPool::Builder {
+    auto nodes = numa_nodes();
+
+    std::size_t ncpus = 0;
+    for (const auto &node : nodes) {
+        ncpus += node.cpus.size();
+    }
+
+    return blank()
+        .policy(TaskPolicy::STEAL)
+        .max_workers(ncpus)
+        .init_workers(ncpus)
+        .nodes(std::move(nodes));
+}
+
 } // namespace nexus::exec::thread_builder
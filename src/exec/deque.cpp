@@ -0,0 +1,100 @@
+#include "nexus/private/exec/deque.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace nexus::exec::detail {
+
+TaskDeque::TaskDeque() {
+    _buffers.push_back(std::make_unique<Buffer>(INIT_CAPACITY));
+    _buffer.store(_buffers.back().get(), std::memory_order_relaxed);
+}
+
+TaskDeque::~TaskDeque() {
+    while (pop() != nullptr) {
+    }
+}
+
+auto TaskDeque::push(Task<> &&task) -> void {
+    auto  alloc = PoolAllocator<Task<>>();
+    auto *box = alloc.allocate(1);
+    ::new (static_cast<void *>(box)) Task<>(std::move(task));
+
+    auto bottom = _bottom.load(std::memory_order_relaxed);
+    auto top = _top.load(std::memory_order_acquire);
+    auto *buffer = _buffer.load(std::memory_order_relaxed);
+
+    if (bottom - top > buffer->capacity() - 1) {
+        buffer = _grow(buffer, bottom, top);
+    }
+
+    buffer->put(bottom, box);
+    std::atomic_thread_fence(std::memory_order_release);
+    _bottom.store(bottom + 1, std::memory_order_relaxed);
+}
+
+auto TaskDeque::pop() -> TaskPtr {
+    auto bottom = _bottom.load(std::memory_order_relaxed) - 1;
+    auto *buffer = _buffer.load(std::memory_order_relaxed);
+    _bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto top = _top.load(std::memory_order_relaxed);
+
+    // Empty deque.
+    if (top > bottom) {
+        _bottom.store(bottom + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    auto *task = buffer->get(bottom);
+
+    // More than one task, no race with thieves.
+    if (top != bottom) {
+        return TaskPtr(task);
+    }
+
+    // Last task, race with thieves.
+    if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+        task = nullptr;
+    }
+    _bottom.store(bottom + 1, std::memory_order_relaxed);
+
+    return TaskPtr(task);
+}
+
+auto TaskDeque::steal() -> TaskPtr {
+    auto top = _top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto bottom = _bottom.load(std::memory_order_acquire);
+
+    if (top >= bottom) {
+        return nullptr;
+    }
+
+    auto *task = _buffer.load(std::memory_order_acquire)->get(top);
+    if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+        return nullptr;
+    }
+
+    return TaskPtr(task);
+}
+
+auto TaskDeque::_grow(Buffer *buffer, std::int64_t bottom, std::int64_t top)
+    -> Buffer * {
+    auto next = std::make_unique<Buffer>(buffer->capacity() * 2);
+    for (auto idx = top; idx < bottom; ++idx) {
+        next->put(idx, buffer->get(idx));
+    }
+
+    _buffers.push_back(std::move(next));
+    _buffer.store(_buffers.back().get(), std::memory_order_release);
+
+    return _buffers.back().get();
+}
+
+} // namespace nexus::exec::detail
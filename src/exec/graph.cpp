@@ -0,0 +1,142 @@
+#include "nexus/exec/thread/graph.hpp"
+#include "nexus/exec/thread/pool.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+namespace nexus::exec {
+
+namespace {
+
+constexpr TaskGraph::NodeId NO_NODE = SIZE_MAX;
+
+} // namespace
+
+auto TaskGraph::run(ThreadPool &pool) -> std::future<void> {
+    if (_running.exchange(true)) {
+        throw std::logic_error("task graph is already running");
+    }
+
+    _pool = &pool;
+    _failed.store(false);
+    _error = nullptr;
+    _done = std::promise<void>();
+    auto fut = _done.get_future();
+
+    for (auto &node : _nodes) {
+        node->pending.store(node->deps.size(), std::memory_order_relaxed);
+        node->poisoned.store(false, std::memory_order_relaxed);
+    }
+    for (auto &result : _results) {
+        result.reset();
+    }
+
+    if (_nodes.empty()) {
+        _running.store(false);
+        _done.set_value();
+        return fut;
+    }
+
+    // Published to workers by the queue lock of the posts below.
+    _remaining.store(_nodes.size(), std::memory_order_relaxed);
+    for (auto source : _sources) {
+        _post(source);
+    }
+
+    return fut;
+}
+
+auto TaskGraph::_add(NodeFunction &&func, std::span<const NodeId> deps)
+    -> NodeId {
+    if (_running.load()) {
+        throw std::logic_error("task graph is running");
+    }
+
+    auto id = _nodes.size();
+    for (auto dep : deps) {
+        if (dep >= id) {
+            throw std::out_of_range("dependency is not in the graph");
+        }
+    }
+
+    auto node = std::make_unique<Node>();
+    node->func = std::move(func);
+    node->deps.assign(deps.begin(), deps.end());
+
+    for (auto dep : deps) {
+        _nodes[dep]->succs.push_back(id);
+    }
+    if (deps.empty()) {
+        _sources.push_back(id);
+    }
+
+    _nodes.push_back(std::move(node));
+    _results.emplace_back();
+
+    return id;
+}
+
+auto TaskGraph::_execute(NodeId node) -> void {
+    while (node != NO_NODE) {
+        auto &cur = *_nodes[node];
+
+        // Dependents of a failed node are skipped, but still counted down,
+        // independent branches keep running.
+        auto poisoned = cur.poisoned.load(std::memory_order_relaxed);
+        if (!poisoned) {
+            try {
+                _results[node] = cur.func(Inputs(this, cur.deps));
+            } catch (...) {
+                poisoned = true;
+                if (!_failed.exchange(true)) {
+                    _error = std::current_exception();
+                }
+            }
+        }
+
+        node = NO_NODE;
+        for (auto succ : cur.succs) {
+            auto &next = *_nodes[succ];
+            if (poisoned) {
+                next.poisoned.store(true, std::memory_order_relaxed);
+            }
+
+            // Acquire results and poison of other dependencies, release ours.
+            if (next.pending.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+                continue;
+            }
+
+            if (node != NO_NODE) {
+                _post(node);
+            }
+            node = succ;
+        }
+
+        if (_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            // Nothing else touches the graph after this.
+            auto done = std::move(_done);
+            auto error = _error;
+            _running.store(false);
+
+            if (error != nullptr) {
+                done.set_exception(error);
+            } else {
+                done.set_value();
+            }
+            return;
+        }
+    }
+}
+
+auto TaskGraph::_post(NodeId node) -> void {
+    _pool->post([this, node]() { _execute(node); });
+}
+
+} // namespace nexus::exec
@@ -0,0 +1,83 @@
+#include "nexus/exec/thread/group.hpp"
+#include "nexus/exec/thread/pool.hpp"
+
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace nexus::exec {
+
+TaskGroup::~TaskGroup() { _wait(); }
+
+auto TaskGroup::wait() -> void {
+    _wait();
+
+    if (_error != nullptr) {
+        _failed.store(false, std::memory_order_relaxed);
+        std::rethrow_exception(std::exchange(_error, nullptr));
+    }
+}
+
+auto TaskGroup::_spawn(std::shared_ptr<detail::GroupChild> child) -> void {
+    // The spawner (owner, or a running child) keeps the group alive until
+    // the child is pushed.
+    _latch.add();
+    try {
+        _pool->post([this, child]() {
+            if (child->claim()) {
+                _run(*child);
+            }
+        });
+    } catch (...) {
+        _latch.cancel();
+        throw;
+    }
+
+    auto guard = std::lock_guard(_lock);
+    _children.push_back(std::move(child));
+}
+
+auto TaskGroup::_take() -> std::shared_ptr<detail::GroupChild> {
+    auto guard = std::lock_guard(_lock);
+    while (!_children.empty()) {
+        auto child = std::move(_children.back());
+        _children.pop_back();
+        if (child->claim()) {
+            return child;
+        }
+    }
+    return nullptr;
+}
+
+auto TaskGroup::_run(detail::GroupChild &child) -> void {
+    if (!_failed.load(std::memory_order_relaxed)) {
+        try {
+            child.call();
+        } catch (...) {
+            if (!_failed.exchange(true)) {
+                _error = std::current_exception();
+            }
+        }
+    }
+
+    _latch.done();
+}
+
+auto TaskGroup::_wait() -> void {
+    _latch.wait(*_pool, [this]() {
+        auto child = _take();
+        if (child == nullptr) {
+            return false;
+        }
+        _run(*child);
+        return true;
+    });
+
+    // All children ran, the rest of the stack was claimed by workers.
+    auto guard = std::lock_guard(_lock);
+    _children.clear();
+}
+
+} // namespace nexus::exec
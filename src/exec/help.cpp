@@ -0,0 +1,61 @@
+#include "nexus/private/exec/help.hpp"
+#include "nexus/exec/thread/pool.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+
+namespace nexus::exec::detail {
+
+auto HelpLatch::done() -> void {
+    auto cur = _pending.load(std::memory_order_relaxed);
+    while (cur > 1) {
+        if (_pending.compare_exchange_weak(cur, cur - 1,
+                                           std::memory_order_acq_rel,
+                                           std::memory_order_relaxed)) {
+            return;
+        }
+    }
+
+    // Maybe the last one, the waiter takes the lock before returning.
+    auto guard = std::lock_guard(_lock);
+    _pending.fetch_sub(1, std::memory_order_acq_rel);
+    _cond.notify_all();
+}
+
+auto HelpLatch::wait(ThreadPool &pool, const OwnFn &own) -> void {
+    auto is_zero = [this]() {
+        return _pending.load(std::memory_order_acquire) == 0;
+    };
+    auto member = pool.is_worker();
+
+    std::size_t idle = 0;
+    while (!is_zero()) {
+        // Other threads only run their own tasks, unrelated tasks may block
+        // or need locks the caller holds.
+        if ((own && own()) || (member && pool.try_run_one())) {
+            idle = 0;
+            continue;
+        }
+
+        if (member && ++idle < HELP_SPINS) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        auto guard = std::unique_lock(_lock);
+        if (member) {
+            // Sleep a while, then one helping round before sleeping again.
+            _cond.wait_for(guard, HELP_PARK, is_zero);
+        } else {
+            _cond.wait(guard, is_zero);
+        }
+    }
+
+    // The last task finishes under the lock, the latch can be destroyed once
+    // it is released.
+    auto guard = std::lock_guard(_lock);
+}
+
+} // namespace nexus::exec::detail
@@ -0,0 +1,102 @@
+#include "nexus/exec/thread/metrics.hpp"
+#include "nexus/private/exec/metrics.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace nexus::exec {
+
+auto Histogram::record(std::uint64_t value, std::uint64_t cnt) -> void {
+    if (cnt == 0) {
+        return;
+    }
+
+    _counts[bucket(value)] += cnt;
+    _count += cnt;
+    _sum += value * cnt;
+    _min = std::min(_min, value);
+    _max = std::max(_max, value);
+}
+
+auto Histogram::merge(const Histogram &other) -> void {
+    for (std::size_t i = 0; i < BUCKETS; ++i) {
+        _counts[i] += other._counts[i];
+    }
+    _count += other._count;
+    _sum += other._sum;
+    _min = std::min(_min, other._min);
+    _max = std::max(_max, other._max);
+}
+
+auto Histogram::percentile(double pct) const -> std::uint64_t {
+    if (_count == 0) {
+        return 0;
+    }
+
+    auto rank = static_cast<std::uint64_t>(
+        std::ceil(std::clamp(pct, 0.0, 100.0) / 100.0 *
+                  static_cast<double>(_count)));
+    rank = std::max<std::uint64_t>(rank, 1);
+
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < BUCKETS; ++i) {
+        seen += _counts[i];
+        if (seen >= rank) {
+            return std::min(bucket_max(i), _max);
+        }
+    }
+
+    return _max;
+}
+
+auto Histogram::bucket(std::uint64_t value) -> std::size_t {
+    if (value < SUB_BUCKETS) {
+        return value;
+    }
+
+    auto shift = static_cast<std::size_t>(std::bit_width(value)) - 1 - SUB_BITS;
+    return ((shift + 1) * SUB_BUCKETS) + ((value >> shift) & (SUB_BUCKETS - 1));
+}
+
+auto Histogram::bucket_max(std::size_t idx) -> std::uint64_t {
+    if (idx < SUB_BUCKETS) {
+        return idx;
+    }
+
+    auto shift = (idx / SUB_BUCKETS) - 1;
+    auto low = (SUB_BUCKETS + (idx % SUB_BUCKETS)) << shift;
+    return low + ((std::uint64_t(1) << shift) - 1);
+}
+
+namespace detail {
+
+auto AtomicHistogram::load(Histogram &out) const -> void {
+    std::uint64_t count = 0;
+    for (std::size_t i = 0; i < Histogram::BUCKETS; ++i) {
+        auto cnt = _counts[i].load(std::memory_order_relaxed);
+        out._counts[i] += cnt;
+        count += cnt;
+    }
+
+    if (count == 0) {
+        return;
+    }
+
+    out._count += count;
+    out._sum += _sum.load(std::memory_order_relaxed);
+    out._min = std::min(out._min, _min.load(std::memory_order_relaxed));
+    out._max = std::max(out._max, _max.load(std::memory_order_relaxed));
+}
+
+auto current_stats() -> WorkerStats *& {
+    thread_local WorkerStats *stats = nullptr;
+    return stats;
+}
+
+} // namespace detail
+
+} // namespace nexus::exec
@@ -0,0 +1,137 @@
+#include "nexus/exec/thread/numa.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+    #include <sched.h>
+#endif
+
+namespace nexus::exec {
+
+namespace {
+
+constexpr std::string_view NODE_PREFIX = "node";
+
+/**
+ * @brief Parse a decimal number, the whole string should be consumed.
+ *
+ * @param str Number string.
+ * @return std::optional<std::size_t> Number.
+ */
+auto parse_number(std::string_view str) -> std::optional<std::size_t> {
+    std::size_t num = 0;
+    const auto *end = str.data() + str.size();
+
+    auto [ptr, err] = std::from_chars(str.data(), end, num);
+    if (err != std::errc() || ptr != end || str.empty()) {
+        return {};
+    }
+
+    return num;
+}
+
+/**
+ * @brief Single node with all cpus, used if sysfs is not available.
+ *
+ * @return std::vector<NumaNode> Nodes.
+ */
+auto fallback_nodes() -> std::vector<NumaNode> {
+    auto ncpus = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+
+    auto node = NumaNode{.id = 0, .cpus = {}};
+    for (std::size_t i = 0; i < ncpus; ++i) {
+        node.cpus.push_back(i);
+    }
+
+    return {std::move(node)};
+}
+
+} // namespace
+
+auto numa_nodes(const std::filesystem::path &root) -> std::vector<NumaNode> {
+    auto nodes = std::vector<NumaNode>();
+    auto err = std::error_code();
+
+    for (const auto &entry : std::filesystem::directory_iterator(root, err)) {
+        auto name = entry.path().filename().string();
+        if (!name.starts_with(NODE_PREFIX)) {
+            continue;
+        }
+
+        auto id =
+            parse_number(std::string_view(name).substr(NODE_PREFIX.size()));
+        if (!id.has_value()) {
+            continue;
+        }
+
+        auto file = std::ifstream(entry.path() / "cpulist");
+        auto list = std::string();
+        std::getline(file, list);
+
+        auto cpus = parse_cpu_list(list);
+        if (!cpus.empty()) {
+            nodes.push_back({.id = id.value(), .cpus = std::move(cpus)});
+        }
+    }
+
+    if (nodes.empty()) {
+        return fallback_nodes();
+    }
+
+    std::ranges::sort(nodes, {}, &NumaNode::id);
+    return nodes;
+}
+
+auto parse_cpu_list(std::string_view list) -> std::vector<std::size_t> {
+    auto cpus = std::vector<std::size_t>();
+
+    while (!list.empty() && (list.back() == '\n' || list.back() == ' ')) {
+        list.remove_suffix(1);
+    }
+
+    while (!list.empty()) {
+        auto pos = list.find(',');
+        auto range = list.substr(0, pos);
+        list = pos == std::string_view::npos ? "" : list.substr(pos + 1);
+
+        auto dash = range.find('-');
+        auto first = parse_number(range.substr(0, dash));
+        auto last = dash == std::string_view::npos
+                        ? first
+                        : parse_number(range.substr(dash + 1));
+
+        if (!first.has_value() || !last.has_value() ||
+            first.value() > last.value()) {
+            return {};
+        }
+
+        for (auto cpu = first.value(); cpu <= last.value(); ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+
+    return cpus;
+}
+
+auto current_cpu() -> std::optional<std::size_t> {
+#ifdef __linux__
+    auto cpu = sched_getcpu();
+    if (cpu >= 0) {
+        return static_cast<std::size_t>(cpu);
+    }
+#endif
+    return {};
+}
+
+} // namespace nexus::exec
@@ -1,33 +1,108 @@
 #include "nexus/exec/thread/pool.hpp"
+#include "nexus/exec/thread/timer.hpp"
 #include "nexus/exec/thread/worker.hpp"
+#include "nexus/private/exec/task.hpp"
+#include "nexus/private/exec/timer.hpp"
 
 #include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <memory>
 #include <mutex>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 
 namespace nexus::exec {
 
-ThreadPool::ThreadPool(const Config &cfg)
-    : _cfg(cfg), _queue(std::make_shared<TaskQueue>(_cfg.policy)) {
+ThreadPool::ThreadPool(const Config &cfg) : _cfg(cfg) {
     if (_cfg.max_workers < _cfg.min_workers) {
         throw std::range_error("max_workers is smaller than min_workers");
     }
 
+    auto queue_cnt = std::max<std::size_t>(_cfg.nodes.size(), 1);
+    for (std::size_t i = 0; i < queue_cnt; ++i) {
+        _queues.push_back(std::make_shared<TaskQueue>(
+            _cfg.policy, _cfg.max_workers, _cfg.capacity));
+        _queues.back()->error_handler(_cfg.error_handler);
+        _queues.back()->miss_policy(_cfg.miss_policy, _cfg.miss_handler);
+    }
+
+    for (std::size_t i = 0; i < _cfg.nodes.size(); ++i) {
+        for (auto cpu : _cfg.nodes[i].cpus) {
+            if (cpu >= _cpu_node.size()) {
+                _cpu_node.resize(cpu + 1, 0);
+            }
+            _cpu_node[cpu] = i;
+        }
+    }
+
+    _timers = std::make_unique<detail::TimerWheel>(this);
+
     resize_workers(_cfg.init_workers);
+
+    if (_cfg.autoscale.enabled) {
+        _scaler = std::jthread(
+            [this](const std::stop_token &stop) { _autoscale_loop(stop); });
+    }
 }
 
-ThreadPool::~ThreadPool() { release(); }
+ThreadPool::~ThreadPool() {
+    // Stop the autoscaler first, it must not resize a released pool.
+    if (_scaler.joinable()) {
+        _scaler.request_stop();
+        _scaler.join();
+    }
+    // Then timers, they must not post to released queues.
+    _timers->stop();
+
+    release();
+}
 
 auto ThreadPool::push(TaskType &&task) -> std::future<Result> {
+    return push(std::move(task), _local_node());
+}
+
+auto ThreadPool::push(TaskType &&task, std::size_t node)
+    -> std::future<Result> {
+    auto &queue = _queues.at(node);
+
     auto fut = task.get_future();
-    _queue->push(std::move(task));
+    queue->push(std::move(task));
+    _wakeup_stealer(node);
+
     return fut;
 }
 
+auto ThreadPool::push_bulk(std::span<TaskType> tasks)
+    -> std::vector<std::future<Result>> {
+    auto futs = std::vector<std::future<Result>>();
+    futs.reserve(tasks.size());
+    for (auto &task : tasks) {
+        futs.push_back(task.detached() ? std::future<Result>()
+                                       : task.get_future());
+    }
+
+    auto node = _local_node();
+    _queues[node]->push_bulk(tasks);
+    _wakeup_stealer(node);
+
+    return futs;
+}
+
 auto ThreadPool::resize_workers(std::size_t new_size) -> void {
     auto guard = std::lock_guard(_lock);
+    _resize(new_size);
+}
 
+auto ThreadPool::_resize(std::size_t new_size) -> void {
     new_size = std::max(new_size, _cfg.min_workers);
     new_size = std::min(new_size, _cfg.max_workers);
 
@@ -42,11 +117,15 @@ auto ThreadPool::resize_workers(std::size_t new_size) -> void {
     //   1. Reuse from _cancelled_workers.
     //   2. Create new Workers.
     if (prev_size < new_size) {
-        auto diff = new_size - prev_size;
-        diff -= _reuse_workers(diff);
-        for (std::size_t i = 0; i < diff; ++i) {
-            _workers.emplace_back(_queue);
-            _workers.back().run();
+        auto counts = _node_workers();
+        for (auto i = prev_size; i < new_size; ++i) {
+            // Refill the node which lost the most workers.
+            auto node = static_cast<std::size_t>(
+                std::ranges::min_element(counts) - counts.begin());
+            if (!_reuse_worker(node)) {
+                _spawn_worker(node);
+            }
+            ++counts[node];
         }
         return;
     }
@@ -61,6 +140,45 @@ auto ThreadPool::resize_workers(std::size_t new_size) -> void {
     }
 }
 
+auto ThreadPool::try_run_one() -> bool {
+    auto local = _local_node();
+    for (std::size_t i = 0; i < _queues.size(); ++i) {
+        auto &queue = _queues[(local + i) % _queues.size()];
+        auto  task = queue->try_pop();
+        if (!task.has_value()) {
+            continue;
+        }
+
+        try {
+            if (task->deadline() != TaskType::NO_DEADLINE &&
+                task->deadline() < std::chrono::steady_clock::now() &&
+                !queue->handle_miss(*task)) {
+                return true;
+            }
+            (*task)();
+        } catch (...) {
+            queue->handle_error(std::current_exception());
+        }
+        return true;
+    }
+
+    return false;
+}
+
+auto ThreadPool::is_worker() const -> bool {
+    return std::ranges::any_of(
+        _queues, [](const QueuePtr &queue) { return queue->attached(); });
+}
+
+auto ThreadPool::timers() const -> std::size_t { return _timers->size(); }
+
+auto ThreadPool::_schedule(std::chrono::steady_clock::time_point deadline,
+                           std::chrono::steady_clock::duration   period,
+                           detail::TaskFunction<void()>        &&func)
+    -> TimerHandle {
+    return _timers->add(deadline, period, std::move(func));
+}
+
 auto ThreadPool::report() -> Report {
     auto guard = std::lock_guard(_lock);
 
@@ -74,42 +192,271 @@ auto ThreadPool::report() -> Report {
     }
 
     res.running = _workers.size();
+
+    // Counters are aggregated here, workers only touch their own.
+    auto &metrics = res.metrics;
+    metrics = _retired;
+    for (const auto &worker : _workers) {
+        metrics.workers.push_back(worker.collect(metrics));
+    }
+    for (const auto &worker : _cancelled_workers) {
+        metrics.workers.push_back(worker.collect(metrics));
+    }
+
+    for (const auto &queue : _queues) {
+        metrics.depth += queue->size();
+        metrics.peak_depth = std::max(metrics.peak_depth, queue->peak_size());
+    }
+    metrics.uptime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - _created);
+
+    return res;
+}
+
+auto ThreadPool::_autoscale_loop(const std::stop_token &stop) -> void {
+    auto now = std::chrono::steady_clock::now();
+    auto state =
+        ScaleState{.last_check = now,
+                   .last_grow = now,
+                   .window_start = now,
+                   .executed = 0,
+                   .min_parked = std::vector(_queues.size(), SIZE_MAX)};
+
+    auto lock = std::mutex();
+    auto cond = std::condition_variable_any();
+
+    while (true) {
+        {
+            auto guard = std::unique_lock(lock);
+            cond.wait_for(guard, stop, _cfg.autoscale.interval,
+                          []() { return false; });
+        }
+
+        if (stop.stop_requested()) {
+            break;
+        }
+
+        _autoscale(state);
+    }
+}
+
+auto ThreadPool::_autoscale(ScaleState &state) -> void {
+    auto guard = std::lock_guard(_lock);
+
+    const auto &scale = _cfg.autoscale;
+    auto        now = std::chrono::steady_clock::now();
+
+    std::size_t depth = 0;
+    for (const auto &queue : _queues) {
+        depth += queue->size();
+    }
+
+    auto executed = _executed();
+    auto done = executed > state.executed ? executed - state.executed : 0;
+    auto elapsed = now - state.last_check;
+    state.executed = executed;
+    state.last_check = now;
+
+    auto workers = _workers.size();
+
+    // Little's law: wait = depth / throughput, no progress counts as too
+    // long.
+    auto too_deep =
+        depth > scale.grow_depth * std::max<std::size_t>(workers, 1);
+    auto too_slow =
+        depth != 0 && (done == 0 || elapsed * depth / done > scale.max_wait);
+
+    if ((too_deep || too_slow) && workers < _cfg.max_workers) {
+        _resize(workers + std::max<std::size_t>(workers / 2, 1));
+
+        state.last_grow = now;
+        state.window_start = now;
+        std::ranges::fill(state.min_parked, SIZE_MAX);
+        return;
+    }
+
+    // Workers of a node parked through the whole window are surplus.
+    for (std::size_t node = 0; node < _queues.size(); ++node) {
+        state.min_parked[node] =
+            std::min(state.min_parked[node], _queues[node]->parked());
+    }
+    if (now - state.window_start < scale.keep_alive) {
+        return;
+    }
+
+    if (now - state.last_grow >= scale.keep_alive) {
+        auto counts = _node_workers();
+        auto spare = workers - std::min(workers, _cfg.min_workers);
+        for (std::size_t node = 0; node < _queues.size() && spare != 0;
+             ++node) {
+            // Keep one worker per node, its queue would wait on stealers.
+            auto cnt = std::min({state.min_parked[node],
+                                 counts[node] - std::min<std::size_t>(
+                                                    counts[node], 1),
+                                 spare});
+            spare -= _cancel_node_workers(node, cnt);
+        }
+
+        if (_cfg.remove_cancelled) {
+            _clean_cancelled_workers();
+        }
+    }
+
+    state.window_start = now;
+    std::ranges::fill(state.min_parked, SIZE_MAX);
+}
+
+auto ThreadPool::_executed() const -> std::uint64_t {
+    auto res = _retired.executed;
+    for (const auto &worker : _workers) {
+        res += worker.executed();
+    }
+    for (const auto &worker : _cancelled_workers) {
+        res += worker.executed();
+    }
+
     return res;
 }
 
-auto ThreadPool::_reuse_workers(std::size_t need) -> std::size_t {
-    std::size_t wake_cnt = 0;
-    while (!_cancelled_workers.empty() && wake_cnt < need) {
-        _workers.push_back(std::move(_cancelled_workers.front()));
-        _cancelled_workers.pop_front();
+auto ThreadPool::_local_node() const -> std::size_t {
+    if (_queues.size() == 1) {
+        return 0;
+    }
+
+    auto cpu = current_cpu();
+    if (!cpu.has_value() || cpu.value() >= _cpu_node.size()) {
+        return 0;
+    }
+
+    return _cpu_node[cpu.value()];
+}
+
+auto ThreadPool::_wakeup_stealer(std::size_t node) -> void {
+    // Workers of the node will take the task.
+    if (_queues.size() == 1 || _queues[node]->parked() != 0) {
+        return;
+    }
+
+    for (std::size_t i = 1; i < _queues.size(); ++i) {
+        auto &other = _queues[(node + i) % _queues.size()];
+        if (other->parked() != 0) {
+            other->wakeup();
+            return;
+        }
+    }
+}
+
+auto ThreadPool::_spawn_worker(std::size_t node) -> void {
+    auto cfg = ThreadWorker::Config();
+    cfg.batch_size = _cfg.batch_size;
+    cfg.idle_policy = _cfg.idle_policy;
+    cfg.spin_count = _cfg.spin_count;
+    cfg.fifo_priority = _cfg.fifo_priority;
+    cfg.nice = _cfg.nice;
+    cfg.stack_size = _cfg.stack_size;
+
+    if (!_cfg.name_prefix.empty()) {
+        cfg.name = _cfg.name_prefix + std::to_string(_spawned);
+    }
 
-        _workers.back().uncancel();
-        ++wake_cnt;
+    if (_cfg.nodes.empty() && !_cfg.cpus.empty()) {
+        cfg.cpus = _cfg.pin_per_worker
+                       ? std::vector{_cfg.cpus[_spawned % _cfg.cpus.size()]}
+                       : _cfg.cpus;
     }
 
-    return wake_cnt;
+    if (!_cfg.nodes.empty()) {
+        const auto &cpus = _cfg.nodes[node].cpus;
+        if (!cpus.empty()) {
+            cfg.cpus = {cpus[_node_workers()[node] % cpus.size()]};
+        }
+
+        for (std::size_t i = 1; i < _queues.size(); ++i) {
+            cfg.steal_from.push_back(_queues[(node + i) % _queues.size()]);
+        }
+    }
+
+    _workers.emplace_back(_queues[node], cfg);
+    _workers.back().run();
+    ++_spawned;
+}
+
+auto ThreadPool::_reuse_worker(std::size_t node) -> bool {
+    auto wit = std::ranges::find_if(
+        _cancelled_workers,
+        [this, node](const auto &worker) { return _node_of(worker) == node; });
+    if (wit == _cancelled_workers.end()) {
+        return false;
+    }
+
+    _workers.push_back(std::move(*wit));
+    _cancelled_workers.erase(wit);
+
+    _workers.back().uncancel();
+    return true;
 }
 
 auto ThreadPool::_cancel_workers(std::size_t need) -> std::size_t {
     std::size_t cancel_cnt = 0;
+    auto        counts = _node_workers();
     while (!_workers.empty() && cancel_cnt < need) {
-        _cancelled_workers.push_back(std::move(_workers.front()));
-        _workers.pop_front();
+        auto node = static_cast<std::size_t>(
+            std::ranges::max_element(counts) - counts.begin());
+        cancel_cnt += _cancel_node_workers(node, 1);
+        --counts[node];
+    }
 
-        _cancelled_workers.back().cancel();
-        ++cancel_cnt;
+    return cancel_cnt;
+}
+
+auto ThreadPool::_cancel_node_workers(std::size_t node, std::size_t need)
+    -> std::size_t {
+    std::size_t cancel_cnt = 0;
+
+    // Parked workers first, then any worker of the node.
+    for (auto parked_only : {true, false}) {
+        auto wit = _workers.begin();
+        while (wit != _workers.end() && cancel_cnt < need) {
+            if (_node_of(*wit) != node || (parked_only && !wit->parked())) {
+                ++wit;
+                continue;
+            }
+
+            _cancelled_workers.push_back(std::move(*wit));
+            wit = _workers.erase(wit);
+
+            _cancelled_workers.back().cancel();
+            ++cancel_cnt;
+        }
     }
 
-    _queue->wakeup_all();
     return cancel_cnt;
 }
 
+auto ThreadPool::_node_of(const ThreadWorker &worker) const -> std::size_t {
+    for (std::size_t node = 0; node < _queues.size(); ++node) {
+        if (_queues[node] == worker.queue()) {
+            return node;
+        }
+    }
+    return 0;
+}
+
+auto ThreadPool::_node_workers() const -> std::vector<std::size_t> {
+    auto counts = std::vector<std::size_t>(_queues.size(), 0);
+    for (const auto &worker : _workers) {
+        ++counts[_node_of(worker)];
+    }
+    return counts;
+}
+
 auto ThreadPool::_clean_cancelled_workers() -> std::size_t {
     auto        cit = _cancelled_workers.begin();
     std::size_t clean_cnt = 0;
 
     while (cit != _cancelled_workers.end()) {
         if ((*cit).is_cancelled()) {
+            (*cit).collect(_retired);
             cit = _cancelled_workers.erase(cit);
             ++clean_cnt;
         } else {
@@ -1,34 +1,233 @@
 #include "nexus/exec/queue.hpp"
 #include "nexus/exec/policy.hpp"
+#include "nexus/private/exec/deque.hpp"
+#include "nexus/private/exec/metrics.hpp"
 #include "nexus/private/exec/queue.hpp"
+#include "nexus/private/exec/random.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <thread>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace nexus::exec {
 
-const std::unordered_map<TaskPolicy, TaskQueue::InnerPtr (*)()>
+namespace {
+
+thread_local const TaskQueue    *tls_queue = nullptr;
+thread_local detail::WorkerSlot *tls_slot = nullptr;
+thread_local const TaskQueue    *tls_worker = nullptr;
+
+} // namespace
+
+const std::unordered_map<TaskPolicy, TaskQueue::InnerPtr (*)(
+                               const detail::TaskQueueConfig &)>
     TaskQueue::POLICY_CREATOR = {{TaskPolicy::FIFO, detail::_make_fifo_queue},
                                  {TaskPolicy::LIFO, detail::_make_lifo_queue},
                                  {TaskPolicy::PRIO, detail::_make_prio_queue},
-                                 {TaskPolicy::RAND, detail::_make_rand_queue}};
+                                 {TaskPolicy::RAND, detail::_make_rand_queue},
+                                 {TaskPolicy::STEAL, detail::_make_fifo_queue},
+                                 {TaskPolicy::RING, detail::_make_ring_queue},
+                                 {TaskPolicy::EDF, detail::_make_edf_queue}};
+
+TaskQueue::TaskQueue(TaskPolicy policy, std::size_t workers,
+                     std::size_t capacity)
+    : _inner(POLICY_CREATOR.at(policy)(
+          {.workers = workers, .capacity = capacity})),
+      _concurrent(_inner->self_synchronized()) {
+    if (policy == TaskPolicy::STEAL) {
+        _slots = std::make_unique<detail::WorkerSlot[]>(workers);
+        _slot_cnt = workers;
+        _concurrent = true;
+    }
+}
+
+TaskQueue::~TaskQueue() = default;
 
 auto TaskQueue::push(TaskType &&task) -> void {
+    task.enqueued(std::chrono::steady_clock::now());
+
+    if (_slots != nullptr) {
+        _push_steal(std::move(task));
+        return;
+    }
+
+    if (_concurrent) {
+        // Count first, so `_size` never drops below what poppers can see.
+        _add_size(1);
+        if (!_inner->try_push(std::move(task))) {
+            _push_full(std::move(task));
+        }
+        _wakeup_sleepers();
+        return;
+    }
+
     auto guard = std::unique_lock(_lock);
 
     _inner->push(std::move(task));
-    _size.fetch_add(1);
+    _add_size(1);
 
-    guard.unlock();
-    _cond.notify_one();
+    _parked.unpark(1);
+}
+
+auto TaskQueue::push_bulk(std::span<TaskType> tasks) -> void {
+    if (tasks.empty()) {
+        return;
+    }
+
+    auto  cnt = tasks.size();
+    auto *local = _local_slot();
+
+    auto now = std::chrono::steady_clock::now();
+    for (auto &task : tasks) {
+        task.enqueued(now);
+    }
+
+    if (local != nullptr) {
+        _add_size(cnt);
+        for (auto &task : tasks) {
+            local->deque.push(std::move(task));
+        }
+        _wakeup_sleepers(cnt);
+        return;
+    }
+
+    if (_concurrent && _slots == nullptr) {
+        _add_size(cnt);
+        auto woken = false;
+        for (auto &task : tasks) {
+            // Bounded queue is full, wake workers to drain it before blocking.
+            if (!_inner->try_push(std::move(task))) {
+                _wakeup_sleepers(cnt);
+                woken = true;
+                _push_full(std::move(task));
+            }
+        }
+        if (!woken) {
+            _wakeup_sleepers(cnt);
+        }
+        return;
+    }
+
+    auto guard = std::unique_lock(_lock);
+
+    for (auto &task : tasks) {
+        _inner->push(std::move(task));
+    }
+    if (_slots != nullptr) {
+        _injected.fetch_add(cnt);
+    }
+    _add_size(cnt);
+
+    _parked.unpark(cnt);
 }
 
 auto TaskQueue::pop() -> TaskType {
+    auto parker = detail::Parker();
+
+    if (_concurrent) {
+        return _pop_wait([]() { return false; }, parker).value();
+    }
+
+    auto guard = std::unique_lock(_lock);
+
+    _park(guard, parker, [this]() { return !this->empty(); });
+
+    return _pop_impl();
+}
+
+auto TaskQueue::try_pop() -> std::optional<TaskType> {
+    if (_concurrent) {
+        return _try_pop();
+    }
+
+    if (empty()) {
+        return {};
+    }
+
     auto guard = std::unique_lock(_lock);
-    _cond.wait(guard, [this]() { return !this->empty(); });
+    if (empty()) {
+        return {};
+    }
 
     return _pop_impl();
 }
 
+auto TaskQueue::attach() -> bool {
+    _worker_cnt.fetch_add(1);
+    tls_worker = this;
+
+    for (std::size_t i = 0; i < _slot_cnt; ++i) {
+        auto expected = false;
+        if (_slots[i].attached.compare_exchange_strong(expected, true)) {
+            tls_queue = this;
+            tls_slot = &_slots[i];
+            return true;
+        }
+    }
+
+    return false;
+}
+
+auto TaskQueue::detach() -> void {
+    _worker_cnt.fetch_sub(1);
+    tls_worker = nullptr;
+
+    auto *local = _local_slot();
+    if (local == nullptr) {
+        return;
+    }
+
+    auto guard = std::unique_lock(_lock);
+
+    std::size_t moved = 0;
+    while (auto task = local->deque.pop()) {
+        _inner->push(std::move(*task));
+        ++moved;
+    }
+    _injected.fetch_add(moved);
+    _parked.unpark(moved);
+    guard.unlock();
+
+    tls_queue = nullptr;
+    tls_slot = nullptr;
+    local->attached.store(false);
+}
+
+auto TaskQueue::attached() const -> bool { return tls_worker == this; }
+
+auto TaskQueue::handle_error(std::exception_ptr err) -> void {
+    if (_error_handler) {
+        _error_handler(std::move(err));
+    }
+}
+
+auto TaskQueue::handle_miss(TaskType &task) -> bool {
+    switch (_miss_policy) {
+    case MissPolicy::Run:
+        return true;
+    case MissPolicy::Drop:
+        break;
+    case MissPolicy::Handle:
+        if (_miss_handler) {
+            _miss_handler(std::move(task));
+        }
+        break;
+    }
+
+    return false;
+}
+
 auto TaskQueue::_pop_impl() -> TaskType {
     auto task = _inner->pop();
     _size.fetch_sub(1);
@@ -36,4 +235,189 @@ auto TaskQueue::_pop_impl() -> TaskType {
     return task;
 }
 
+auto TaskQueue::_pop_bulk_impl(std::vector<TaskType> &out, std::size_t max)
+    -> std::size_t {
+    auto cnt = _fair_share(_size.load(), max);
+    for (std::size_t i = 0; i < cnt; ++i) {
+        out.push_back(_inner->pop());
+    }
+    _size.fetch_sub(cnt);
+
+    return cnt;
+}
+
+auto TaskQueue::_try_pop_bulk(std::vector<TaskType> &out, std::size_t max)
+    -> std::size_t {
+    auto *local = _local_slot();
+
+    // Move a share of the injection queue into the local deque, so the batch
+    // stays visible to thieves.
+    if (_slots != nullptr) {
+        if (local == nullptr || _injected.load() == 0) {
+            return 0;
+        }
+
+        auto guard = std::unique_lock(_lock);
+
+        auto cnt = _fair_share(_injected.load(), max);
+        cnt = std::min(cnt, _injected.load());
+        for (std::size_t i = 0; i < cnt; ++i) {
+            local->deque.push(_inner->pop());
+        }
+        _injected.fetch_sub(cnt);
+
+        return 0;
+    }
+
+    auto cnt = _fair_share(_size.load(), max);
+    std::size_t popped = 0;
+    while (popped < cnt) {
+        auto task = _try_pop();
+        if (!task.has_value()) {
+            break;
+        }
+
+        out.push_back(std::move(task.value()));
+        ++popped;
+    }
+
+    return popped;
+}
+
+auto TaskQueue::_fair_share(std::size_t avail, std::size_t max) const
+    -> std::size_t {
+    auto workers = std::max<std::size_t>(_worker_cnt.load(), 1);
+    auto share = (avail + workers - 1) / workers;
+
+    return std::clamp<std::size_t>(share, 1, max);
+}
+
+auto TaskQueue::_push_full(TaskType &&task) -> void {
+    // Workers are producers too, if all of them waited on a full queue
+    // nothing would drain it, so a worker runs one task before each retry.
+    auto worker = attached();
+
+    while (!_inner->try_push(std::move(task))) {
+        if (worker) {
+            if (auto other = _try_pop(); other.has_value()) {
+                _run_inline(*other);
+                continue;
+            }
+        }
+
+        _wakeup_sleepers();
+        std::this_thread::yield();
+    }
+}
+
+auto TaskQueue::_run_inline(TaskType &task) -> void {
+    try {
+        if (task.deadline() != TaskType::NO_DEADLINE &&
+            task.deadline() < std::chrono::steady_clock::now() &&
+            !handle_miss(task)) {
+            return;
+        }
+        task();
+    } catch (...) {
+        handle_error(std::current_exception());
+    }
+}
+
+auto TaskQueue::_push_steal(TaskType &&task) -> void {
+    auto *local = _local_slot();
+
+    // External threads feed the injection queue.
+    if (local == nullptr) {
+        auto guard = std::unique_lock(_lock);
+
+        _inner->push(std::move(task));
+        _injected.fetch_add(1);
+        _add_size(1);
+
+        _parked.unpark(1);
+        return;
+    }
+
+    _add_size(1);
+    local->deque.push(std::move(task));
+    _wakeup_sleepers();
+}
+
+auto TaskQueue::_try_pop() -> std::optional<TaskType> {
+    if (_slots != nullptr) {
+        return _try_pop_steal();
+    }
+
+    auto task = _inner->try_pop();
+    if (task.has_value()) {
+        _size.fetch_sub(1);
+    }
+
+    return task;
+}
+
+auto TaskQueue::_try_pop_steal() -> std::optional<TaskType> {
+    auto *local = _local_slot();
+
+    // Local deque first, the newest task is most likely cache hot.
+    if (local != nullptr) {
+        auto task = local->deque.pop();
+        if (task != nullptr) {
+            _size.fetch_sub(1);
+            return std::move(*task);
+        }
+    }
+
+    // Then the injection queue.
+    if (_injected.load() != 0) {
+        auto guard = std::unique_lock(_lock);
+        if (_injected.load() != 0) {
+            _injected.fetch_sub(1);
+            return _pop_impl();
+        }
+    }
+
+    // Steal from other workers, start from a random victim.
+    if (_slot_cnt == 0) {
+        return {};
+    }
+
+    auto start =
+        detail::thread_random().bounded(static_cast<std::uint32_t>(_slot_cnt));
+    for (std::size_t i = 0; i < _slot_cnt; ++i) {
+        auto &victim = _slots[(start + i) % _slot_cnt];
+        if (&victim == local || victim.deque.empty()) {
+            continue;
+        }
+
+        auto task = victim.deque.steal();
+        if (task != nullptr) {
+            _size.fetch_sub(1);
+
+            // Only attached workers count it here, a steal by an unattached
+            // worker is counted by its worker loop.
+            auto *stats = detail::current_stats();
+            if (local != nullptr && stats != nullptr) {
+                detail::bump(stats->steals);
+            }
+            return std::move(*task);
+        }
+    }
+
+    return {};
+}
+
+auto TaskQueue::_wakeup_sleepers(std::size_t cnt) -> void {
+    if (_parked.size() == 0) {
+        return;
+    }
+
+    auto guard = std::unique_lock(_lock);
+    _parked.unpark(cnt);
+}
+
+auto TaskQueue::_local_slot() const -> detail::WorkerSlot * {
+    return tls_queue == this ? tls_slot : nullptr;
+}
+
 } // namespace nexus::exec
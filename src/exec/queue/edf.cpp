@@ -0,0 +1,68 @@
+#include "nexus/exec/task.hpp"
+#include "nexus/private/exec/queue.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace nexus::exec::detail {
+
+/**
+ * @brief Task queue implementation with earliest deadline first, tasks with
+ * the same deadline (or none) are popped in push order.
+ *
+ */
+class EDF_TaskQueueInner : public TaskQueueInner {
+  private:
+    /**
+     * @brief Heap entry, the key is copied out of the task so sifting does
+     * not touch it.
+     *
+     */
+    struct Entry {
+        std::chrono::steady_clock::time_point deadline;
+        std::uint64_t                         seq;
+        Task<>                                task;
+    };
+
+    /**
+     * @brief Heap order, `std::push_heap` keeps the greatest on top.
+     *
+     */
+    constexpr static auto LATER = [](const Entry &lhs, const Entry &rhs) {
+        return lhs.deadline != rhs.deadline ? lhs.deadline > rhs.deadline
+                                            : lhs.seq > rhs.seq;
+    };
+
+    std::vector<Entry> _heap;
+    std::uint64_t      _seq{0};
+
+  public:
+    EDF_TaskQueueInner() = default;
+
+    auto push(Task<> &&task) -> void override {
+        auto deadline = task.deadline();
+        _heap.push_back(
+            {.deadline = deadline, .seq = _seq++, .task = std::move(task)});
+        std::ranges::push_heap(_heap, LATER);
+    }
+
+    auto pop() -> Task<> override {
+        std::ranges::pop_heap(_heap, LATER);
+        auto task = std::move(_heap.back().task);
+        _heap.pop_back();
+        return task;
+    }
+
+    auto size() -> std::size_t override { return _heap.size(); };
+};
+
+auto _make_edf_queue(const TaskQueueConfig & /*cfg*/)
+    -> std::unique_ptr<TaskQueueInner> {
+    return std::make_unique<EDF_TaskQueueInner>();
+}
+
+} // namespace nexus::exec::detail
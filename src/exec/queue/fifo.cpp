@@ -1,7 +1,7 @@
 #include "nexus/exec/task.hpp"
+#include "nexus/private/exec/bucket.hpp"
 #include "nexus/private/exec/queue.hpp"
 
-#include <deque>
 #include <memory>
 #include <utility>
 
@@ -10,28 +10,26 @@ namespace nexus::exec::detail {
 /**
  * @brief Task queue implementation with FIFO policy.
  *
+ * @note Backed by a growable ring, a warm queue does not allocate.
  */
 class FIFO_TaskQueueInner : public TaskQueueInner {
   private:
-    std::deque<Task<>> _queue;
+    TaskRing _queue;
 
   public:
     FIFO_TaskQueueInner() = default;
 
     auto push(Task<> &&task) -> void override {
-        _queue.push_back(std::move(task));
+        _queue.push(std::move(task));
     }
 
-    auto pop() -> Task<> override {
-        auto task = std::move(_queue.front());
-        _queue.pop_front();
-        return task;
-    }
+    auto pop() -> Task<> override { return _queue.pop(); }
 
     auto size() -> std::size_t override { return _queue.size(); };
 };
 
-auto _make_fifo_queue() -> std::unique_ptr<TaskQueueInner> {
+auto _make_fifo_queue(const TaskQueueConfig & /*cfg*/)
+    -> std::unique_ptr<TaskQueueInner> {
     return std::make_unique<FIFO_TaskQueueInner>();
 }
 
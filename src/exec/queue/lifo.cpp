@@ -1,18 +1,20 @@
 #include "nexus/exec/task.hpp"
 #include "nexus/private/exec/queue.hpp"
 
-#include <deque>
 #include <utility>
+#include <vector>
 
 namespace nexus::exec::detail {
 
 /**
  * @brief Task queue implementation with LIFO policy.
  *
+ * @note Backed by a vector, a warm queue keeps its capacity and does not
+ * allocate.
  */
 class LIFO_TaskQueueInner : public TaskQueueInner {
   private:
-    std::deque<Task<>> _queue;
+    std::vector<Task<>> _queue;
 
   public:
     LIFO_TaskQueueInner() = default;
@@ -30,7 +32,8 @@ class LIFO_TaskQueueInner : public TaskQueueInner {
     auto size() -> std::size_t override { return _queue.size(); };
 };
 
-auto _make_lifo_queue() -> std::unique_ptr<TaskQueueInner> {
+auto _make_lifo_queue(const TaskQueueConfig & /*cfg*/)
+    -> std::unique_ptr<TaskQueueInner> {
     return std::make_unique<LIFO_TaskQueueInner>();
 }
 
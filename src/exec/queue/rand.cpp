@@ -1,79 +1,142 @@
-#include "nexus/common.hpp"
 #include "nexus/exec/task.hpp"
 #include "nexus/private/exec/queue.hpp"
+#include "nexus/private/exec/random.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
-#include <list>
-#include <queue>
-#include <random>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
 #include <utility>
 
 namespace nexus::exec::detail {
 
 /**
- * @brief Task queue implementation in RAND policy, same as PRIO_TaskQueueInner,
- * but the RAND_TaskQueueInner will set the priority to a random number.
+ * @brief Task queue implementation in RAND policy, tasks are spread over
+ * per-worker sub-queues with power-of-two-choices: a push goes to the shorter
+ * of two random sub-queues, a pop takes from the longer one.
  *
+ * @note Sub-queues have their own locks, so `TaskQueue` does not serialize
+ * pushes and pops on one lock.
  */
 class RAND_TaskQueueInner : public TaskQueueInner {
   private:
     /**
-     * @brief Helper object to index the task.
+     * @brief Sub-queue, aligned to avoid false sharing between locks.
      *
      */
-    struct TaskHandle {
-        std::list<Task<>>::iterator it; // NOLINT
-
-        NEXUS_INLINE auto operator<=>(const TaskHandle &other) const {
-            return (*it) <=> (*other.it);
-        };
+    struct alignas(CACHE_LINE_SIZE) Shard {
+        std::mutex         lock;
+        std::deque<Task<>> tasks;
+        std::atomic_size_t size{0};
     };
 
-    /**
-     * @brief Method `top` of priority_queue returns a `const_reference`, which
-     * does not support move.
-     * So PRIO_TaskQueueInner uses list to store tasks and uses priority_queue
-     * only to index the list.
-     *
-     */
-    std::list<Task<>>               _tasks;
-    std::priority_queue<TaskHandle> _queue;
-
-    std::random_device                    _rnd;
-    std::mt19937                          _rnd_gen{_rnd()};
-    std::uniform_int_distribution<int8_t> _rnd_dist;
+    std::unique_ptr<Shard[]> _shards;
+    std::uint32_t            _shard_cnt;
 
   public:
-    RAND_TaskQueueInner() = default;
+    RAND_TaskQueueInner(std::size_t shards)
+        : _shard_cnt(static_cast<std::uint32_t>(std::max<std::size_t>(
+              std::min<std::size_t>(shards, UINT32_MAX), 1))) {
+        _shards = std::make_unique<Shard[]>(_shard_cnt);
+    }
 
-    auto push(Task<> &&task) -> void override {
-        task.prio(_random_prio());
-        _tasks.push_back(std::move(task));
+    auto push(Task<> &&task) -> void override { try_push(std::move(task)); }
 
-        auto task_it = _tasks.end();
-        --task_it;
+    auto pop() -> Task<> override {
+        while (true) {
+            auto task = try_pop();
+            if (task.has_value()) {
+                return std::move(task.value());
+            }
+
+            std::this_thread::yield();
+        }
+    }
 
-        _queue.push({.it = task_it});
+    auto size() -> std::size_t override {
+        std::size_t res = 0;
+        for (std::uint32_t i = 0; i < _shard_cnt; ++i) {
+            res += _shards[i].size.load(std::memory_order_relaxed);
+        }
+        return res;
     }
 
-    auto pop() -> Task<> override {
-        auto task_handle = _queue.top();
-        _queue.pop();
+    [[nodiscard]] auto self_synchronized() const -> bool override {
+        return true;
+    }
 
-        auto task = std::move(*task_handle.it);
-        _tasks.erase(task_handle.it);
+    auto try_push(Task<> &&task) -> bool override {
+        auto [lhs, rhs] = _choose_two();
+        auto &shard = lhs->size.load(std::memory_order_relaxed) <=
+                              rhs->size.load(std::memory_order_relaxed)
+                          ? *lhs
+                          : *rhs;
 
-        return task;
+        auto guard = std::lock_guard(shard.lock);
+        shard.tasks.push_back(std::move(task));
+        shard.size.fetch_add(1, std::memory_order_relaxed);
+
+        return true;
     }
 
-    auto size() -> std::size_t override { return _queue.size(); };
+    auto try_pop() -> std::optional<Task<>> override {
+        auto [lhs, rhs] = _choose_two();
+        if (lhs->size.load(std::memory_order_relaxed) <
+            rhs->size.load(std::memory_order_relaxed)) {
+            std::swap(lhs, rhs);
+        }
+
+        auto task = _pop_from(*lhs);
+        if (task.has_value()) {
+            return task;
+        }
+
+        // Both choices may be empty, scan the rest from a random start.
+        auto start = thread_random().bounded(_shard_cnt);
+        for (std::uint32_t i = 0; i < _shard_cnt; ++i) {
+            auto &shard = _shards[(start + i) % _shard_cnt];
+            if (shard.size.load(std::memory_order_relaxed) == 0) {
+                continue;
+            }
+
+            task = _pop_from(shard);
+            if (task.has_value()) {
+                return task;
+            }
+        }
+
+        return {};
+    }
 
   private:
-    NEXUS_INLINE auto _random_prio() -> int8_t { return _rnd_dist(_rnd_gen); }
+    NEXUS_INLINE auto _choose_two() -> std::pair<Shard *, Shard *> {
+        auto &rnd = thread_random();
+        return {&_shards[rnd.bounded(_shard_cnt)],
+                &_shards[rnd.bounded(_shard_cnt)]};
+    }
+
+    static auto _pop_from(Shard &shard) -> std::optional<Task<>> {
+        auto guard = std::lock_guard(shard.lock);
+        if (shard.tasks.empty()) {
+            return {};
+        }
+
+        auto task = std::move(shard.tasks.front());
+        shard.tasks.pop_front();
+        shard.size.fetch_sub(1, std::memory_order_relaxed);
+
+        return task;
+    }
 };
 
-auto _make_rand_queue() -> std::unique_ptr<TaskQueueInner> {
-    return std::make_unique<RAND_TaskQueueInner>();
+auto _make_rand_queue(const TaskQueueConfig &cfg)
+    -> std::unique_ptr<TaskQueueInner> {
+    return std::make_unique<RAND_TaskQueueInner>(cfg.workers);
 }
 
 } // namespace nexus::exec::detail
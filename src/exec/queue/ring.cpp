@@ -0,0 +1,147 @@
+#include "nexus/exec/task.hpp"
+#include "nexus/private/exec/queue.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <utility>
+
+namespace nexus::exec::detail {
+
+/**
+ * @brief Lock free bounded MPMC task queue (Vyukov style), every cell carries
+ * a sequence number telling producers and consumers whose turn it is.
+ *
+ */
+class RING_TaskQueueInner : public TaskQueueInner {
+  private:
+    /**
+     * @brief Ring cell.
+     *
+     */
+    struct Cell {
+        std::atomic_size_t    seq;
+        std::optional<Task<>> task;
+    };
+
+    std::unique_ptr<Cell[]> _cells;
+    std::size_t             _mask;
+
+    alignas(CACHE_LINE_SIZE) std::atomic_size_t _enqueue{0};
+    alignas(CACHE_LINE_SIZE) std::atomic_size_t _dequeue{0};
+
+  public:
+    explicit RING_TaskQueueInner(std::size_t capacity)
+        : _cells(std::make_unique<Cell[]>(capacity)), _mask(capacity - 1) {
+        for (std::size_t i = 0; i < capacity; ++i) {
+            _cells[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    auto push(Task<> &&task) -> void override {
+        while (!try_push(std::move(task))) {
+            std::this_thread::yield();
+        }
+    }
+
+    auto pop() -> Task<> override {
+        while (true) {
+            auto task = try_pop();
+            if (task.has_value()) {
+                return std::move(task.value());
+            }
+
+            std::this_thread::yield();
+        }
+    }
+
+    auto size() -> std::size_t override {
+        auto dequeue = _dequeue.load(std::memory_order_relaxed);
+        auto enqueue = _enqueue.load(std::memory_order_relaxed);
+        return enqueue > dequeue ? enqueue - dequeue : 0;
+    }
+
+    [[nodiscard]] auto self_synchronized() const -> bool override {
+        return true;
+    }
+
+    auto try_push(Task<> &&task) -> bool override {
+        auto  pos = _enqueue.load(std::memory_order_relaxed);
+        Cell *cell = nullptr;
+
+        while (true) {
+            cell = &_cells[pos & _mask];
+            auto seq = cell->seq.load(std::memory_order_acquire);
+            auto diff = static_cast<std::intptr_t>(seq) -
+                        static_cast<std::intptr_t>(pos);
+
+            // Cell is free, claim it.
+            if (diff == 0) {
+                if (_enqueue.compare_exchange_weak(
+                        pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+                continue;
+            }
+
+            // Cell still holds a task from the last lap, queue is full.
+            if (diff < 0) {
+                return false;
+            }
+
+            pos = _enqueue.load(std::memory_order_relaxed);
+        }
+
+        cell->task.emplace(std::move(task));
+        cell->seq.store(pos + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    auto try_pop() -> std::optional<Task<>> override {
+        auto  pos = _dequeue.load(std::memory_order_relaxed);
+        Cell *cell = nullptr;
+
+        while (true) {
+            cell = &_cells[pos & _mask];
+            auto seq = cell->seq.load(std::memory_order_acquire);
+            auto diff = static_cast<std::intptr_t>(seq) -
+                        static_cast<std::intptr_t>(pos + 1);
+
+            // Cell holds a task, claim it.
+            if (diff == 0) {
+                if (_dequeue.compare_exchange_weak(
+                        pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+                continue;
+            }
+
+            // Cell is not filled yet, queue is empty.
+            if (diff < 0) {
+                return {};
+            }
+
+            pos = _dequeue.load(std::memory_order_relaxed);
+        }
+
+        auto task = std::move(cell->task);
+        cell->task.reset();
+        cell->seq.store(pos + _mask + 1, std::memory_order_release);
+
+        return task;
+    }
+};
+
+auto _make_ring_queue(const TaskQueueConfig &cfg)
+    -> std::unique_ptr<TaskQueueInner> {
+    return std::make_unique<RING_TaskQueueInner>(
+        std::bit_ceil(std::max<std::size_t>(cfg.capacity, 2)));
+}
+
+} // namespace nexus::exec::detail
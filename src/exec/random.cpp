@@ -0,0 +1,19 @@
+#include "nexus/private/exec/random.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <thread>
+
+namespace nexus::exec::detail {
+
+auto thread_random() -> FastRandom & {
+    thread_local auto rnd = FastRandom(
+        std::hash<std::thread::id>()(std::this_thread::get_id()) ^
+        static_cast<std::uint64_t>(
+            std::chrono::steady_clock::now().time_since_epoch().count()));
+
+    return rnd;
+}
+
+} // namespace nexus::exec::detail
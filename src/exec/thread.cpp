@@ -0,0 +1,64 @@
+#include "nexus/private/exec/thread.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <system_error>
+#include <utility>
+
+#ifdef __linux__
+    #include <climits>
+    #include <pthread.h>
+#else
+    #include <thread>
+#endif
+
+namespace nexus::exec::detail {
+
+#ifdef __linux__
+
+namespace {
+
+auto thread_entry(void *arg) -> void * {
+    auto func = std::unique_ptr<NativeThread::Function>(
+        static_cast<NativeThread::Function *>(arg));
+    (*func)();
+    return nullptr;
+}
+
+} // namespace
+
+NativeThread::NativeThread(std::size_t stack_size, Function func) {
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    if (stack_size != 0) {
+        auto min_size = static_cast<std::size_t>(PTHREAD_STACK_MIN);
+        pthread_attr_setstacksize(&attr, std::max(stack_size, min_size));
+    }
+
+    auto entry = std::make_unique<Function>(std::move(func));
+    auto ret = pthread_create(&_handle, &attr, thread_entry, entry.get());
+    pthread_attr_destroy(&attr);
+
+    if (ret != 0) {
+        throw std::system_error(ret, std::generic_category(),
+                                "pthread_create");
+    }
+
+    // Owned by the thread now.
+    entry.release(); // NOLINT
+}
+
+NativeThread::~NativeThread() { pthread_join(_handle, nullptr); }
+
+#else
+
+NativeThread::NativeThread(std::size_t /*stack_size*/, Function func)
+    : _thread(std::move(func)) {}
+
+NativeThread::~NativeThread() { _thread.join(); }
+
+#endif
+
+} // namespace nexus::exec::detail
@@ -0,0 +1,325 @@
+#include "nexus/private/exec/timer.hpp"
+#include "nexus/exec/thread/pool.hpp"
+#include "nexus/exec/thread/timer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace nexus::exec {
+
+auto TimerHandle::cancel() -> bool {
+    return _wheel != nullptr && _wheel->cancel(_id, _gen);
+}
+
+} // namespace nexus::exec
+
+namespace nexus::exec::detail {
+
+TimerWheel::TimerWheel(ThreadPool *pool) : _pool(pool) { _slots.fill(NIL); }
+
+TimerWheel::~TimerWheel() { stop(); }
+
+auto TimerWheel::add(Clock::time_point deadline, Clock::duration period,
+                     Function &&func) -> TimerHandle {
+    auto guard = std::unique_lock(_lock);
+
+    if (_pending == 0) {
+        // Nothing to cascade, skip the idle ticks.
+        _now = std::max(_now, _floor_tick(Clock::now()));
+    }
+
+    auto id = _alloc();
+    auto &entry = _entries[id];
+    entry.func = std::move(func);
+    entry.deadline = deadline;
+    entry.period = period;
+
+    auto handle = TimerHandle(this, id, entry.gen);
+    if (!_stopped && !_thread.joinable()) {
+        _thread = std::jthread(
+            [this](const std::stop_token &stop) { _loop(stop); });
+    }
+    _arm(guard, id);
+
+    return handle;
+}
+
+auto TimerWheel::cancel(std::uint32_t id, std::uint32_t gen) -> bool {
+    // Destroyed after the lock is released.
+    auto func = Function();
+    auto guard = std::lock_guard(_lock);
+
+    if (id >= _entries.size()) {
+        return false;
+    }
+
+    auto &entry = _entries[id];
+    if (entry.gen != gen) {
+        return false;
+    }
+
+    switch (entry.state) {
+    case State::PENDING:
+        _unlink(id);
+        func = std::move(entry.func);
+        _release(id);
+        return true;
+    case State::RUNNING:
+        // A periodic timer is released by its last run.
+        if (entry.period == Clock::duration::zero() || entry.cancelled) {
+            return false;
+        }
+        entry.cancelled = true;
+        return true;
+    case State::FREE:
+        break;
+    }
+
+    return false;
+}
+
+auto TimerWheel::stop() -> void {
+    {
+        auto guard = std::lock_guard(_lock);
+        _stopped = true;
+    }
+
+    if (_thread.joinable()) {
+        _thread.request_stop();
+        _thread.join();
+    }
+}
+
+auto TimerWheel::size() -> std::size_t {
+    auto guard = std::lock_guard(_lock);
+    return _pending;
+}
+
+auto TimerWheel::_loop(const std::stop_token &stop) -> void {
+    auto guard = std::unique_lock(_lock);
+    auto expired = std::vector<Entry *>();
+
+    while (!stop.stop_requested()) {
+        if (_pending == 0) {
+            _wake = UINT64_MAX;
+            _cond.wait(guard, stop, [this]() { return _pending != 0; });
+            continue;
+        }
+
+        auto target = _floor_tick(Clock::now());
+        while (_now < target && _pending != 0) {
+            _advance(expired);
+        }
+        _now = std::max(_now, target);
+
+        if (!expired.empty()) {
+            _post(guard, expired);
+            guard.lock();
+            continue;
+        }
+
+        // Woken up early if a sooner timer is added.
+        auto wake = _next_tick();
+        _wake = wake;
+        _cond.wait_until(guard, stop,
+                         _origin + TICK * static_cast<Clock::rep>(wake),
+                         [this, wake]() { return _wake != wake; });
+    }
+}
+
+auto TimerWheel::_advance(std::vector<Entry *> &expired) -> void {
+    ++_now;
+
+    // A slot of level `l` cascades when the lower bits of the tick wrap.
+    for (std::size_t level = 1; level < LEVELS; ++level) {
+        auto shift = SLOT_BITS * level;
+        if ((_now & ((std::uint64_t(1) << shift) - 1)) != 0) {
+            break;
+        }
+
+        auto id = std::exchange(
+            _slots[(level * SLOTS) + ((_now >> shift) & (SLOTS - 1))], NIL);
+        while (id != NIL) {
+            auto next = _entries[id].next;
+            --_pending;
+            if (!_link(id)) {
+                expired.push_back(&_entries[id]);
+            }
+            id = next;
+        }
+    }
+
+    // Entries of a level 0 slot all expire at this tick.
+    auto id = std::exchange(_slots[_now & (SLOTS - 1)], NIL);
+    while (id != NIL) {
+        auto next = _entries[id].next;
+        --_pending;
+        expired.push_back(&_entries[id]);
+        id = next;
+    }
+}
+
+auto TimerWheel::_next_tick() const -> std::uint64_t {
+    auto cascade = (_now | (SLOTS - 1)) + 1;
+    for (auto tick = _now + 1; tick < cascade; ++tick) {
+        if (_slots[tick & (SLOTS - 1)] != NIL) {
+            return tick;
+        }
+    }
+    return cascade;
+}
+
+auto TimerWheel::_link(std::uint32_t id) -> bool {
+    auto &entry = _entries[id];
+    if (entry.expiry <= _now) {
+        return false;
+    }
+
+    auto expiry = entry.expiry;
+    if (expiry - _now >= RANGE) {
+        expiry = _now + RANGE - 1;
+    }
+
+    auto        delta = expiry - _now;
+    std::size_t level = 0;
+    while (delta >= (std::uint64_t(1) << (SLOT_BITS * (level + 1)))) {
+        ++level;
+    }
+
+    auto slot = (level * SLOTS) +
+                ((expiry >> (SLOT_BITS * level)) & (SLOTS - 1));
+    entry.slot = static_cast<std::uint32_t>(slot);
+    entry.prev = NIL;
+    entry.next = _slots[slot];
+    if (entry.next != NIL) {
+        _entries[entry.next].prev = id;
+    }
+    _slots[slot] = id;
+    entry.state = State::PENDING;
+    ++_pending;
+
+    return true;
+}
+
+auto TimerWheel::_unlink(std::uint32_t id) -> void {
+    auto &entry = _entries[id];
+    if (entry.prev != NIL) {
+        _entries[entry.prev].next = entry.next;
+    } else {
+        _slots[entry.slot] = entry.next;
+    }
+    if (entry.next != NIL) {
+        _entries[entry.next].prev = entry.prev;
+    }
+    --_pending;
+}
+
+auto TimerWheel::_arm(std::unique_lock<std::mutex> &guard, std::uint32_t id)
+    -> void {
+    auto &entry = _entries[id];
+    entry.expiry = _ceil_tick(entry.deadline);
+
+    if (!_link(id)) {
+        auto expired = std::vector<Entry *>{&entry};
+        _post(guard, expired);
+        return;
+    }
+
+    if (entry.expiry < _wake) {
+        _wake = entry.expiry;
+        _cond.notify_one();
+    }
+}
+
+auto TimerWheel::_post(std::unique_lock<std::mutex> &guard,
+                       std::vector<Entry *> &expired) -> void {
+    for (auto *entry : expired) {
+        entry->state = State::RUNNING;
+    }
+    guard.unlock();
+
+    for (auto *entry : expired) {
+        _pool->post([this, entry]() { _run(entry); });
+    }
+    expired.clear();
+}
+
+auto TimerWheel::_run(Entry *entry) -> void {
+    auto error = std::exception_ptr();
+    try {
+        entry->func();
+    } catch (...) {
+        // Re-arm first, then pass the error to the pool.
+        error = std::current_exception();
+    }
+
+    // Destroyed after the lock is released.
+    auto func = Function();
+    auto guard = std::unique_lock(_lock);
+
+    if (entry->period == Clock::duration::zero() || entry->cancelled) {
+        func = std::move(entry->func);
+        _release(entry->id);
+    } else {
+        // Fixed rate, missed runs are skipped.
+        entry->deadline =
+            std::max(entry->deadline + entry->period, Clock::now());
+        if (_pending == 0) {
+            _now = std::max(_now, _floor_tick(Clock::now()));
+        }
+        _arm(guard, entry->id);
+    }
+
+    if (error != nullptr) {
+        if (guard.owns_lock()) {
+            guard.unlock();
+        }
+        std::rethrow_exception(error);
+    }
+}
+
+auto TimerWheel::_alloc() -> std::uint32_t {
+    if (!_free.empty()) {
+        auto id = _free.back();
+        _free.pop_back();
+        return id;
+    }
+
+    auto id = static_cast<std::uint32_t>(_entries.size());
+    _entries.emplace_back().id = id;
+    return id;
+}
+
+auto TimerWheel::_release(std::uint32_t id) -> void {
+    auto &entry = _entries[id];
+    entry.state = State::FREE;
+    entry.cancelled = false;
+    ++entry.gen;
+    _free.push_back(id);
+}
+
+auto TimerWheel::_ceil_tick(Clock::time_point tp) const -> std::uint64_t {
+    if (tp <= _origin) {
+        return 0;
+    }
+    return static_cast<std::uint64_t>(
+        std::chrono::ceil<std::chrono::milliseconds>(tp - _origin) / TICK);
+}
+
+auto TimerWheel::_floor_tick(Clock::time_point tp) const -> std::uint64_t {
+    if (tp <= _origin) {
+        return 0;
+    }
+    return static_cast<std::uint64_t>(
+        std::chrono::floor<std::chrono::milliseconds>(tp - _origin) / TICK);
+}
+
+} // namespace nexus::exec::detail
@@ -1,7 +1,81 @@
 #include "nexus/exec/thread/worker.hpp"
+#include "nexus/private/exec/idle.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+    #include <pthread.h>
+    #include <sched.h>
+    #include <sys/resource.h>
+    #include <unistd.h>
+#endif
 
 namespace nexus::exec {
 
+namespace {
+
+constexpr std::size_t MAX_NAME_LEN = 15;
+
+/**
+ * @brief Apply affinity, scheduling and name to calling thread, errors are
+ * ignored (e.g. cpus are not allowed by cgroup, no `CAP_SYS_NICE`).
+ *
+ * @param cfg Worker configuration.
+ */
+auto setup_thread(const ThreadWorker::Config &cfg) -> void {
+#ifdef __linux__
+    if (!cfg.cpus.empty()) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (auto cpu : cfg.cpus) {
+            if (cpu < CPU_SETSIZE) {
+                CPU_SET(cpu, &set);
+            }
+        }
+
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+
+    if (cfg.fifo_priority != 0) {
+        auto param = sched_param{.sched_priority = cfg.fifo_priority};
+        pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    }
+
+    // Nice value is per thread on Linux.
+    if (cfg.nice.has_value()) {
+        setpriority(PRIO_PROCESS, static_cast<id_t>(gettid()),
+                    cfg.nice.value());
+    }
+
+    if (!cfg.name.empty()) {
+        pthread_setname_np(pthread_self(),
+                           cfg.name.substr(0, MAX_NAME_LEN).c_str());
+    }
+#else
+    (void)cfg;
+#endif
+}
+
+/**
+ * @brief Get nanoseconds between two time points, 0 if `to` is before `from`.
+ *
+ */
+auto elapsed_ns(std::chrono::steady_clock::time_point from,
+                std::chrono::steady_clock::time_point to) -> std::uint64_t {
+    auto diff =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count();
+    return diff > 0 ? static_cast<std::uint64_t>(diff) : 0;
+}
+
+} // namespace
+
 auto ThreadWorker::run() -> bool {
     auto guard = std::lock_guard(_inner->lock);
 
@@ -9,23 +83,29 @@ auto ThreadWorker::run() -> bool {
         return false;
     }
 
-    _worker = std::make_unique<std::jthread>(
-        [queue = this->_queue, inner = this->_inner]() mutable {
-            _worker_loop(queue, inner);
-        });
+    // Join the previous thread, it has already left its loop.
+    _worker.reset();
+    _worker = std::make_unique<detail::NativeThread>(
+        _cfg.stack_size,
+        [queue = this->_queue, inner = this->_inner,
+         cfg = this->_cfg]() mutable { _worker_loop(queue, inner, cfg); });
     _inner->status.store(Status::Running);
 
     return true;
 }
 
 auto ThreadWorker::cancel() -> bool {
-    auto guard = std::lock_guard(_inner->lock);
+    auto guard = std::unique_lock(_inner->lock);
 
     if (is_cancelled() || is_created()) {
         return false;
     }
 
     _inner->status.store(Status::CancelWait);
+    guard.unlock();
+
+    // Wake up only this worker to see the cancel.
+    _queue->unpark(_inner->parker);
 
     return true;
 }
@@ -54,18 +134,121 @@ auto ThreadWorker::wait_for_cancel() -> void {
     _inner->cancel_notify.wait(guard, [this]() { return is_cancelled(); });
 }
 
-auto ThreadWorker::_worker_loop(const QueuePtr &queue, InnerPtr &inner)
-    -> void {
+auto ThreadWorker::collect(PoolMetrics &out) const -> WorkerMetrics {
+    const auto &stats = _inner->stats;
+    stats.wait.load(out.wait);
+    stats.run.load(out.run);
+
+    auto res = WorkerMetrics{
+        .executed = stats.executed.load(std::memory_order_relaxed),
+        .steals = stats.steals.load(std::memory_order_relaxed),
+        .parks = stats.parks.load(std::memory_order_relaxed),
+        .misses = stats.misses.load(std::memory_order_relaxed),
+        .late = stats.late.load(std::memory_order_relaxed)};
+    out.executed += res.executed;
+    out.steals += res.steals;
+    out.parks += res.parks;
+    out.misses += res.misses;
+    out.late += res.late;
+
+    return res;
+}
+
+auto ThreadWorker::_worker_loop(const QueuePtr &queue, InnerPtr &inner,
+                                const Config &cfg) -> void {
+    setup_thread(cfg);
+    queue->attach();
+
+    auto &stats = inner->stats;
+    detail::current_stats() = &stats;
+
+    auto batch = std::vector<TaskQueue::TaskType>();
+    batch.reserve(cfg.batch_size);
+
+    auto is_cancel_wait = [&inner]() {
+        return inner->status.load() == Status::CancelWait;
+    };
+
+    // Other queues are only checked when the own queue is empty.
+    auto can_steal = [&queue, &cfg]() {
+        return queue->empty() &&
+               std::ranges::any_of(cfg.steal_from, [](const auto &other) {
+                   return !other->empty();
+               });
+    };
+    auto idle = detail::IdleBackoff(cfg.idle_policy, cfg.spin_count);
+
     while (true) {
-        auto task = queue->pop(
-            [&inner]() { return inner->status.load() == Status::CancelWait; });
+        // Spin before parking, a task arriving soon skips the futex wake.
+        if (queue->empty()) {
+            idle.wait([&queue, &is_cancel_wait, &can_steal]() {
+                return !queue->empty() || is_cancel_wait() || can_steal();
+            });
+        }
 
-        if (task.has_value()) {
-            task.value()();
+        queue->pop_bulk(
+            batch, cfg.batch_size,
+            [&is_cancel_wait, &can_steal]() {
+                return is_cancel_wait() || can_steal();
+            },
+            inner->parker);
+
+        if (batch.empty() && !is_cancel_wait()) {
+            _steal(cfg.steal_from, batch);
+            detail::bump(stats.steals, batch.size());
+        }
+        if (!batch.empty()) {
+            idle.resume();
+        }
+
+        // Tasks are already taken from the queue, run the whole batch even
+        // if a cancel is requested meanwhile. The end of one task is the start
+        // of the next one, one clock read per task.
+        auto start = std::chrono::steady_clock::now();
+        auto ran = std::size_t(0);
+        for (auto &task : batch) {
+            stats.wait.record(elapsed_ns(task.enqueued(), start));
+
+            // A missed task is dropped or handed over before it takes the
+            // worker, unless the policy runs it anyway.
+            auto missed = task.deadline() < start;
+            if (missed) {
+                detail::bump(stats.misses);
+                if (!_take_missed(*queue, task)) {
+                    start = std::chrono::steady_clock::now();
+                    continue;
+                }
+            }
+
+            try {
+                task();
+            } catch (...) {
+                // Only detached tasks throw, others keep errors in futures.
+                queue->handle_error(std::current_exception());
+            }
+
+            auto end = std::chrono::steady_clock::now();
+            stats.run.record(elapsed_ns(start, end));
+            if (!missed && end > task.deadline()) {
+                detail::bump(stats.late);
+            }
+            start = end;
+            ++ran;
+        }
+
+        detail::bump(stats.executed, ran);
+        batch.clear();
+
+        // Only take the lock when a cancel is requested.
+        if (inner->status.load() != Status::CancelWait) {
+            continue;
         }
 
         auto guard = std::unique_lock(inner->lock);
         if (inner->status == Status::CancelWait) {
+            // Hand over local tasks before anyone can rerun the worker.
+            queue->detach();
+            detail::current_stats() = nullptr;
             inner->status.store(Status::Cancel);
 
             guard.unlock();
@@ -76,4 +259,25 @@ auto ThreadWorker::_worker_loop(const QueuePtr &queue, InnerPtr &inner)
     }
 }
 
+auto ThreadWorker::_take_missed(TaskQueue &queue, TaskQueue::TaskType &task)
+    -> bool {
+    try {
+        return queue.handle_miss(task);
+    } catch (...) {
+        queue.handle_error(std::current_exception());
+    }
+    return false;
+}
+
+auto ThreadWorker::_steal(const std::vector<QueuePtr> &others,
+                          std::vector<TaskQueue::TaskType> &batch) -> void {
+    for (const auto &other : others) {
+        auto task = other->try_pop();
+        if (task.has_value()) {
+            batch.push_back(std::move(task.value()));
+            return;
+        }
+    }
+}
+
 } // namespace nexus::exec
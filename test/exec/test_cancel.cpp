@@ -0,0 +1,72 @@
+#include "nexus/exec/thread.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <gtest/gtest.h>
+#include <latch>
+#include <stop_token>
+#include <thread>
+
+namespace {
+
+namespace builder = nexus::exec::thread_builder;
+
+TEST(Cancel, Queued) {
+    auto pool = builder::blank().max_workers(1).init_workers(1).build();
+    auto called = std::atomic_bool(false);
+
+    // Hold the worker, so the task below stays queued.
+    auto gate = std::latch(1);
+    pool.post([&gate]() { gate.wait(); });
+
+    auto [fut, handle] = pool.submit_cancellable([&called]() {
+        called.store(true);
+        return 1;
+    });
+    EXPECT_TRUE(handle.cancel());
+    EXPECT_TRUE(handle.cancel());
+    gate.count_down();
+
+    EXPECT_THROW(fut.get(), std::future_error);
+    EXPECT_FALSE(called.load());
+}
+
+TEST(Cancel, Running) {
+    auto pool = builder::common().build();
+    auto started = std::latch(1);
+
+    auto [fut, handle] = pool.submit_cancellable(
+        [&started](const std::stop_token &stop, int step) {
+            started.count_down();
+            int iters = 0;
+            // One unit of work before the first check, cancel may come first.
+            do {
+                iters += step;
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            } while (!stop.stop_requested());
+            return iters;
+        },
+        1);
+
+    started.wait();
+    EXPECT_FALSE(handle.cancel());
+    EXPECT_TRUE(handle.token().stop_requested());
+    EXPECT_GT(fut.get(), 0);
+}
+
+TEST(Cancel, Finished) {
+    auto pool = builder::common().build();
+
+    auto [fut, handle] =
+        pool.submit_cancellable([](int lhs, int rhs) { return lhs + rhs; }, 1,
+                                2);
+    EXPECT_EQ(fut.get(), 3);
+    EXPECT_FALSE(handle.cancel());
+
+    auto [none, none_handle] = pool.submit_cancellable([]() {});
+    none.get();
+    EXPECT_TRUE(none_handle.valid());
+}
+
+} // namespace
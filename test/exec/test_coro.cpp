@@ -0,0 +1,144 @@
+#include "nexus/exec/thread.hpp"
+
+#include <atomic>
+#include <future>
+#include <gtest/gtest.h>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+namespace builder = nexus::exec::thread_builder;
+namespace exec = nexus::exec;
+
+auto thread_id() -> exec::CoTask<std::thread::id> {
+    co_return std::this_thread::get_id();
+}
+
+auto hop(exec::ThreadPool &pool) -> exec::CoTask<std::thread::id> {
+    co_await pool.schedule();
+    co_return std::this_thread::get_id();
+}
+
+auto hop_twice(exec::ThreadPool &pool, exec::ThreadPool &other)
+    -> exec::CoTask<std::thread::id> {
+    co_await pool.schedule();
+    co_return co_await hop(other);
+}
+
+auto add(int lhs, int rhs) -> exec::CoTask<int> { co_return lhs + rhs; }
+
+auto sum(int cnt) -> exec::CoTask<int> {
+    int res = 0;
+    for (int i = 0; i < cnt; ++i) {
+        res += co_await add(i, 1);
+    }
+    co_return res;
+}
+
+auto fail() -> exec::CoTask<int> {
+    throw std::runtime_error("failed");
+    co_return 0;
+}
+
+auto catch_fail() -> exec::CoTask<bool> {
+    try {
+        co_await fail();
+    } catch (const std::runtime_error &) {
+        co_return true;
+    }
+    co_return false;
+}
+
+auto yield_many(exec::ThreadPool &pool, int cnt, std::atomic_int &steps)
+    -> exec::CoTask<> {
+    for (int i = 0; i < cnt; ++i) {
+        co_await pool.schedule();
+        steps.fetch_add(1);
+    }
+}
+
+TEST(Coro, Schedule) {
+    auto pool = builder::common().build();
+    auto caller = std::this_thread::get_id();
+
+    auto worker = exec::co_spawn(pool, thread_id()).get();
+    EXPECT_NE(worker, caller);
+
+    auto hopped = exec::co_spawn(pool, hop(pool)).get();
+    EXPECT_NE(hopped, caller);
+
+    EXPECT_THROW((void)pool.schedule_on(pool.nodes()), std::out_of_range);
+}
+
+TEST(Coro, Await) {
+    auto pool = builder::common().build();
+
+    // A long await chain runs on one worker without growing the stack.
+    EXPECT_EQ(exec::co_spawn(pool, sum(10000)).get(), 50005000);
+
+    auto fut = exec::co_spawn(pool, add(1, 2)).then([](int value) {
+        return value * 10;
+    });
+    EXPECT_EQ(fut.get(), 30);
+}
+
+TEST(Coro, Error) {
+    auto pool = builder::common().build();
+
+    EXPECT_THROW(exec::co_spawn(pool, fail()).get(), std::runtime_error);
+    EXPECT_TRUE(exec::co_spawn(pool, catch_fail()).get());
+}
+
+// Many coroutines in flight on a few workers, none pins a thread.
+TEST(Coro, Many) {
+    constexpr static int TASKS = 1000;
+    constexpr static int STEPS = 10;
+
+    auto pool = builder::blank().max_workers(2).init_workers(2).build();
+    auto steps = std::atomic_int(0);
+
+    auto futs = std::vector<exec::Future<void>>();
+    futs.reserve(TASKS);
+    for (int i = 0; i < TASKS; ++i) {
+        futs.push_back(exec::co_spawn(pool, yield_many(pool, STEPS, steps)));
+    }
+    exec::when_all(std::move(futs)).get();
+
+    EXPECT_EQ(steps.load(), TASKS * STEPS);
+}
+
+// A pool dropping the task before it starts breaks the future.
+TEST(Coro, Broken) {
+    auto fut = std::optional<exec::Future<int>>();
+
+    {
+        auto pool = builder::blank().min_workers(0).init_workers(0).build();
+        fut.emplace(exec::co_spawn(pool, add(1, 2)));
+    }
+
+    EXPECT_THROW(fut->get(), std::future_error);
+}
+
+// A pool dropping a later hop destroys the whole chain and breaks the future.
+TEST(Coro, BrokenHop) {
+    auto fut = std::optional<exec::Future<std::thread::id>>();
+
+    {
+        auto pool = builder::blank().max_workers(1).init_workers(1).build();
+        auto other = builder::blank().min_workers(0).init_workers(0).build();
+
+        // The second hop goes to a pool without workers.
+        fut.emplace(exec::co_spawn(pool, hop_twice(pool, other)));
+        while (other.report().metrics.depth == 0) {
+            std::this_thread::yield();
+        }
+    }
+
+    EXPECT_THROW(fut->get(), std::future_error);
+}
+
+} // namespace
@@ -0,0 +1,137 @@
+#include "nexus/exec/thread.hpp"
+
+#include <atomic>
+#include <future>
+#include <gtest/gtest.h>
+#include <latch>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+namespace builder = nexus::exec::thread_builder;
+namespace exec = nexus::exec;
+
+TEST(Future, Then) {
+    auto pool = builder::common().build();
+
+    auto fut = exec::async(pool, [](int lhs, int rhs) { return lhs + rhs; }, 1,
+                           2)
+                   .then([](int value) { return value * 10; })
+                   .then([](int value) { return std::to_string(value); });
+
+    EXPECT_EQ(fut.get(), "30");
+
+    auto done = std::atomic_bool(false);
+    exec::async(pool, []() {})
+        .then([&done]() { done.store(true); })
+        .get();
+    EXPECT_TRUE(done.load());
+}
+
+TEST(Future, Error) {
+    auto pool = builder::common().build();
+    auto called = std::atomic_bool(false);
+
+    auto fut = exec::async(pool, []() -> int {
+                   throw std::runtime_error("failed");
+               }).then([&called](int value) {
+        called.store(true);
+        return value;
+    });
+
+    EXPECT_THROW(fut.get(), std::runtime_error);
+    EXPECT_FALSE(called.load());
+}
+
+// A long chain on one worker, no step blocks it.
+TEST(Future, Chain) {
+    constexpr static int CHAIN_LEN = 1000;
+
+    auto pool = builder::blank().max_workers(1).init_workers(1).build();
+
+    auto fut = exec::async(pool, []() { return 0; });
+    for (int i = 0; i < CHAIN_LEN; ++i) {
+        fut = fut.then([](int value) { return value + 1; });
+    }
+
+    EXPECT_EQ(fut.get(), CHAIN_LEN);
+}
+
+TEST(Future, WhenAll) {
+    auto pool = builder::common().build();
+
+    auto all = exec::when_all(exec::async(pool, []() { return 1; }),
+                              exec::async(pool, []() {}),
+                              exec::async(pool, []() { return 2.5; }));
+    auto [lhs, none, rhs] = all.get();
+    EXPECT_EQ(lhs, 1);
+    EXPECT_DOUBLE_EQ(rhs, 2.5);
+    (void)none;
+
+    auto futs = std::vector<exec::Future<int>>();
+    for (int i = 0; i < 16; ++i) {
+        futs.push_back(exec::async(pool, [i]() { return i; }));
+    }
+
+    auto sum = exec::when_all(std::move(futs)).then([](std::vector<int> vals) {
+        int res = 0;
+        for (auto val : vals) {
+            res += val;
+        }
+        return res;
+    });
+    EXPECT_EQ(sum.get(), 120);
+
+    auto failed = exec::when_all(
+        exec::async(pool, []() { return 1; }),
+        exec::async(pool, []() -> int { throw std::runtime_error("failed"); }));
+    EXPECT_THROW(failed.get(), std::runtime_error);
+}
+
+TEST(Future, WhenAny) {
+    // One worker is held by the gate.
+    auto pool = builder::blank().max_workers(2).init_workers(2).build();
+    auto gate = std::latch(1);
+
+    auto futs = std::vector<exec::Future<int>>();
+    futs.push_back(exec::async(pool, [&gate]() {
+        gate.wait();
+        return 0;
+    }));
+    futs.push_back(exec::async(pool, []() { return 1; }));
+
+    auto any = exec::when_any(std::move(futs)).get();
+    EXPECT_EQ(any.index, 1);
+    EXPECT_EQ(any.value, 1);
+
+    gate.count_down();
+}
+
+// A pool dropping the task breaks the future, and the chain behind it.
+TEST(Future, Broken) {
+    auto called = std::atomic_bool(false);
+    auto fut = std::optional<exec::Future<int>>();
+    auto chained = std::optional<exec::Future<int>>();
+
+    {
+        // No worker, the tasks stay queued until the pool is destroyed.
+        auto pool = builder::blank().min_workers(0).init_workers(0).build();
+
+        fut.emplace(exec::async(pool, []() { return 1; }));
+        chained.emplace(exec::async(pool, []() { return 1; })
+                            .then([&called](int value) {
+                                called.store(true);
+                                return value;
+                            }));
+    }
+
+    EXPECT_THROW(fut->get(), std::future_error);
+    EXPECT_THROW(chained->get(), std::future_error);
+    EXPECT_FALSE(called.load());
+}
+
+} // namespace
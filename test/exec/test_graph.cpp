@@ -0,0 +1,133 @@
+#include "nexus/exec/thread.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+namespace builder = nexus::exec::thread_builder;
+
+using nexus::exec::TaskGraph;
+
+TEST(TaskGraph, Diamond) {
+    auto pool = builder::common().build();
+    auto graph = TaskGraph();
+
+    auto src = graph.add([]() { return 1; });
+    auto left = graph.add(
+        [](const TaskGraph::Inputs &in) { return in.get<int>(0) + 1; }, {src});
+    auto right = graph.add(
+        [](const TaskGraph::Inputs &in) { return in.get<int>(0) * 10; }, {src});
+    auto sink = graph.add(
+        [](const TaskGraph::Inputs &in) {
+            return in.get<int>(0) + in.get<int>(1);
+        },
+        {left, right});
+
+    graph.run(pool).get();
+
+    EXPECT_EQ(std::any_cast<int>(graph.result(sink)), 12);
+    EXPECT_EQ(graph.size(), 4);
+}
+
+TEST(TaskGraph, Order) {
+    constexpr static std::size_t WIDTH = 16;
+    constexpr static int RUN_CNT = 64;
+
+    auto pool = builder::common().build();
+    auto graph = TaskGraph();
+
+    // Layers of WIDTH nodes, each depending on the whole previous layer.
+    auto layer_done = std::vector<std::atomic_size_t>(3);
+    auto errors = std::atomic_size_t(0);
+    auto prev = std::vector<TaskGraph::NodeId>();
+    for (std::size_t layer = 0; layer < layer_done.size(); ++layer) {
+        auto cur = std::vector<TaskGraph::NodeId>();
+        for (std::size_t i = 0; i < WIDTH; ++i) {
+            cur.push_back(graph.add(
+                [&layer_done, &errors, layer]() {
+                    if (layer > 0 &&
+                        layer_done[layer - 1].load() % WIDTH != 0) {
+                        errors.fetch_add(1);
+                    }
+                    layer_done[layer].fetch_add(1);
+                },
+                prev));
+        }
+        prev = cur;
+    }
+
+    // A built graph runs many times.
+    for (int run = 0; run < RUN_CNT; ++run) {
+        graph.run(pool).get();
+    }
+
+    EXPECT_EQ(errors.load(), 0);
+    for (const auto &done : layer_done) {
+        EXPECT_EQ(done.load(), WIDTH * RUN_CNT);
+    }
+}
+
+TEST(TaskGraph, Error) {
+    auto pool = builder::common().build();
+    auto graph = TaskGraph();
+    auto ran = std::atomic_bool(false);
+
+    auto fail = graph.add([]() { throw std::runtime_error("failed"); });
+    graph.add([&ran]() { ran.store(true); }, {fail});
+
+    EXPECT_THROW(graph.run(pool).get(), std::runtime_error);
+    EXPECT_FALSE(ran.load());
+
+    EXPECT_THROW(graph.add([]() {}, {5}), std::out_of_range);
+
+    // Empty graph is ready at once.
+    auto empty = TaskGraph();
+    empty.run(pool).get();
+}
+
+// A failure only skips its dependents, not independent branches.
+TEST(TaskGraph, ErrorBranch) {
+    auto pool = builder::blank().max_workers(1).init_workers(1).build();
+    auto graph = TaskGraph();
+    auto dependent = std::atomic_int(0);
+
+    auto fail = graph.add([]() { throw std::runtime_error("failed"); });
+    auto mid = graph.add([&dependent]() { dependent.fetch_add(1); }, {fail});
+    graph.add([&dependent]() { dependent.fetch_add(1); }, {mid});
+
+    auto src = graph.add([]() { return 1; });
+    auto other = graph.add(
+        [](const TaskGraph::Inputs &in) { return in.get<int>(0) + 1; }, {src});
+
+    EXPECT_THROW(graph.run(pool).get(), std::runtime_error);
+    EXPECT_EQ(dependent.load(), 0);
+    EXPECT_EQ(std::any_cast<int>(graph.result(other)), 2);
+
+    // Poison is reset by the next run.
+    EXPECT_THROW(graph.run(pool).get(), std::runtime_error);
+    EXPECT_EQ(std::any_cast<int>(graph.result(other)), 2);
+}
+
+// A chain longer than the pool never blocks a worker.
+TEST(TaskGraph, Chain) {
+    constexpr static int CHAIN_LEN = 1000;
+
+    auto pool = builder::blank().max_workers(1).init_workers(1).build();
+    auto graph = TaskGraph();
+
+    auto prev = graph.add([]() { return 0; });
+    for (int i = 0; i < CHAIN_LEN; ++i) {
+        prev = graph.add(
+            [](const TaskGraph::Inputs &in) { return in.get<int>(0) + 1; },
+            {prev});
+    }
+
+    graph.run(pool).get();
+    EXPECT_EQ(std::any_cast<int>(graph.result(prev)), CHAIN_LEN);
+}
+
+} // namespace
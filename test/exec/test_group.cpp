@@ -0,0 +1,133 @@
+#include "nexus/exec/thread.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <latch>
+#include <stdexcept>
+#include <thread>
+#include <variant>
+
+namespace {
+
+namespace builder = nexus::exec::thread_builder;
+namespace exec = nexus::exec;
+
+auto fib(exec::ThreadPool &pool, int num) -> std::int64_t {
+    if (num < 2) {
+        return num;
+    }
+
+    auto [lhs, rhs] = pool.fork_join([&]() { return fib(pool, num - 1); },
+                                     [&]() { return fib(pool, num - 2); });
+    return lhs + rhs;
+}
+
+TEST(Group, Spawn) {
+    auto pool = builder::blank().max_workers(2).init_workers(2).build();
+    auto group = exec::TaskGroup(pool);
+    auto cnt = std::atomic_int(0);
+
+    for (int i = 0; i < 100; ++i) {
+        group.spawn([&cnt]() { cnt.fetch_add(1); });
+    }
+    group.wait();
+    EXPECT_EQ(cnt.load(), 100);
+
+    // Children spawn into their own group, the group is reusable.
+    for (int i = 0; i < 10; ++i) {
+        group.spawn([&]() {
+            for (int j = 0; j < 10; ++j) {
+                group.spawn([&cnt]() { cnt.fetch_add(1); });
+            }
+        });
+    }
+    group.wait();
+    EXPECT_EQ(cnt.load(), 200);
+}
+
+TEST(Group, Error) {
+    auto pool = builder::blank().max_workers(2).init_workers(2).build();
+    auto group = exec::TaskGroup(pool);
+
+    group.spawn([]() { throw std::runtime_error("bad"); });
+    EXPECT_THROW(group.wait(), std::runtime_error);
+
+    group.spawn([]() {});
+    EXPECT_NO_THROW(group.wait());
+
+    EXPECT_THROW(pool.fork_join([]() { return 1; },
+                                []() -> int { throw std::logic_error("bad"); }),
+                 std::logic_error);
+}
+
+TEST(Group, ForkJoin) {
+    auto pool = builder::blank().max_workers(2).init_workers(2).build();
+
+    EXPECT_EQ(fib(pool, 20), 6765);
+
+    auto [none, val] = pool.fork_join([]() {}, []() { return 2; });
+    EXPECT_EQ(none, std::monostate());
+    EXPECT_EQ(val, 2);
+}
+
+TEST(Group, Nested) {
+    // Every worker waits inside the recursion, blocking on futures would hang.
+    auto pool = builder::cpu_bound().build();
+
+    auto fut = pool.submit([&pool]() { return fib(pool, 18); });
+    EXPECT_EQ(fut.get(), 2584);
+}
+
+TEST(Group, ForeignWorker) {
+    // A worker of another pool waits like any other thread.
+    auto pool = builder::blank().max_workers(1).init_workers(1).build();
+    auto other = builder::blank().max_workers(1).init_workers(1).build();
+
+    EXPECT_FALSE(pool.is_worker());
+    EXPECT_TRUE(pool.submit([&pool]() { return pool.is_worker(); }).get());
+    EXPECT_FALSE(other.submit([&pool]() { return pool.is_worker(); }).get());
+
+    auto fut = other.submit([&pool]() { return fib(pool, 15); });
+    EXPECT_EQ(fut.get(), 610);
+}
+
+// A thread which is not a worker never runs unrelated tasks while waiting.
+TEST(Group, ExternalNoHelp) {
+    using namespace std::chrono_literals;
+
+    auto pool = builder::blank().max_workers(2).init_workers(2).build();
+    auto caller = std::this_thread::get_id();
+
+    // One worker is held by the gate, the other by the child.
+    auto gate = std::latch(1);
+    auto gate_started = std::latch(1);
+    pool.post([&gate, &gate_started]() {
+        gate_started.count_down();
+        gate.wait();
+    });
+    gate_started.wait();
+
+    auto group = exec::TaskGroup(pool);
+    auto child_go = std::latch(1);
+    auto child_started = std::latch(1);
+    group.spawn([&child_go, &child_started]() {
+        child_started.count_down();
+        child_go.wait();
+    });
+    child_started.wait();
+
+    auto unrelated = pool.submit([]() { return std::this_thread::get_id(); });
+
+    auto release = std::jthread([&child_go]() {
+        std::this_thread::sleep_for(20ms);
+        child_go.count_down();
+    });
+    group.wait();
+
+    gate.count_down();
+    EXPECT_NE(unrelated.get(), caller);
+}
+
+} // namespace
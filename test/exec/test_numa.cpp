@@ -0,0 +1,175 @@
+#include "nexus/exec/thread.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+namespace builder = nexus::exec::thread_builder;
+
+using nexus::exec::NumaNode;
+using nexus::exec::TaskPolicy;
+
+/**
+ * @brief Fake sysfs node directory, removed on destruction.
+ *
+ */
+class FakeSysfs {
+  private:
+    std::filesystem::path _root;
+
+  public:
+    FakeSysfs() : _root(_unique_root()) {
+        std::filesystem::create_directories(_root);
+    }
+
+    ~FakeSysfs() { std::filesystem::remove_all(_root); }
+
+    FakeSysfs(const FakeSysfs &other) = delete;
+    auto operator=(const FakeSysfs &other) -> FakeSysfs & = delete;
+
+    FakeSysfs(FakeSysfs &&other) = delete;
+    auto operator=(FakeSysfs &&other) -> FakeSysfs & = delete;
+
+    auto node(const std::string &name, const std::string &cpulist) -> void {
+        std::filesystem::create_directories(_root / name);
+        std::ofstream(_root / name / "cpulist") << cpulist << '\n';
+    }
+
+    [[nodiscard]] auto root() const -> const std::filesystem::path & {
+        return _root;
+    }
+
+  private:
+    /**
+     * @brief Get a directory name unique to this instance, test binaries may
+     * run in parallel.
+     *
+     */
+    static auto _unique_root() -> std::filesystem::path {
+        auto rng = std::random_device();
+        auto name = "nexus_test_numa_" + std::to_string(rng()) + "_" +
+                    std::to_string(rng());
+        return std::filesystem::temp_directory_path() / name;
+    }
+};
+
+TEST(Numa, ParseCpuList) {
+    using Cpus = std::vector<std::size_t>;
+
+    EXPECT_EQ(nexus::exec::parse_cpu_list("0"), Cpus({0}));
+    EXPECT_EQ(nexus::exec::parse_cpu_list("0-3,8,10-11\n"),
+              Cpus({0, 1, 2, 3, 8, 10, 11}));
+    EXPECT_TRUE(nexus::exec::parse_cpu_list("").empty());
+    EXPECT_TRUE(nexus::exec::parse_cpu_list("3-1").empty());
+    EXPECT_TRUE(nexus::exec::parse_cpu_list("a-b").empty());
+}
+
+TEST(Numa, Nodes) {
+    auto sysfs = FakeSysfs();
+    sysfs.node("node1", "4-5");
+    sysfs.node("node0", "0-1");
+    sysfs.node("node2", ""); // Memory only node.
+    sysfs.node("power", "0");
+
+    auto nodes = nexus::exec::numa_nodes(sysfs.root());
+
+    ASSERT_EQ(nodes.size(), 2);
+    EXPECT_EQ(nodes[0].id, 0);
+    EXPECT_EQ(nodes[0].cpus, std::vector<std::size_t>({0, 1}));
+    EXPECT_EQ(nodes[1].id, 1);
+    EXPECT_EQ(nodes[1].cpus, std::vector<std::size_t>({4, 5}));
+}
+
+TEST(Numa, FallbackNodes) {
+    auto nodes = nexus::exec::numa_nodes("/nonexistent/nexus/node");
+
+    ASSERT_EQ(nodes.size(), 1);
+    EXPECT_FALSE(nodes[0].cpus.empty());
+}
+
+TEST(Numa, Pool) {
+    // Two nodes sharing cpu 0, so the test runs on any machine.
+    auto nodes = std::vector<NumaNode>{{.id = 0, .cpus = {0}},
+                                       {.id = 1, .cpus = {0}}};
+
+    auto pool = builder::blank()
+                    .policy(TaskPolicy::STEAL)
+                    .min_workers(1)
+                    .init_workers(1)
+                    .nodes(nodes)
+                    .build();
+
+    EXPECT_EQ(pool.nodes(), 2);
+
+    // Only node 0 has a worker, tasks on node 1 are stolen.
+    auto local = pool.submit_on(0, []() { return 0; });
+    auto remote = pool.submit_on(1, []() { return 1; });
+
+    EXPECT_EQ(local.get(), 0);
+    EXPECT_EQ(remote.get(), 1);
+
+    EXPECT_THROW(pool.submit_on(2, []() { return 2; }), std::out_of_range);
+}
+
+TEST(Numa, AutoScaleShrink) {
+    using namespace std::chrono_literals;
+    constexpr static std::size_t WORKERS = 4;
+
+    auto nodes = std::vector<NumaNode>{{.id = 0, .cpus = {0}},
+                                       {.id = 1, .cpus = {0}}};
+
+    auto scale = nexus::exec::ThreadPool::AutoScale();
+    scale.enabled = true;
+    scale.interval = 1ms;
+    scale.keep_alive = 20ms;
+
+    auto pool = builder::blank()
+                    .policy(TaskPolicy::STEAL)
+                    .min_workers(1)
+                    .max_workers(WORKERS)
+                    .init_workers(WORKERS)
+                    .nodes(nodes)
+                    .autoscale(scale)
+                    .build();
+
+    // One worker stays busy, the other three are parked.
+    auto release = std::promise<void>();
+    auto fut = pool.submit_on(1, [gate = release.get_future().share()]() {
+        gate.wait();
+        return 1;
+    });
+
+    auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (pool.report().running == WORKERS &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(1ms);
+    }
+    std::this_thread::sleep_for(scale.keep_alive * 3);
+
+    // Each node keeps a worker, and only parked workers are cancelled.
+    auto report = pool.report();
+    EXPECT_EQ(report.running, 2);
+    EXPECT_EQ(report.cancel_wait, 0);
+
+    release.set_value();
+    EXPECT_EQ(fut.get(), 1);
+}
+
+TEST(Numa, Builder) {
+    auto pool = builder::numa().build();
+
+    EXPECT_GE(pool.nodes(), 1);
+    EXPECT_EQ(pool.submit([]() { return 42; }).get(), 42); // NOLINT
+}
+
+} // namespace
@@ -0,0 +1,83 @@
+#include "nexus/exec/thread.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <ranges>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+namespace builder = nexus::exec::thread_builder;
+namespace exec = nexus::exec;
+
+TEST(Parallel, For) {
+    constexpr static std::size_t SIZE = 100000;
+
+    auto pool = builder::blank().max_workers(4).init_workers(4).build();
+    auto hits = std::vector<std::atomic_int>(SIZE);
+
+    exec::parallel_for(pool, std::views::iota(std::size_t(0), SIZE),
+                       [&hits](std::size_t idx) { hits[idx].fetch_add(1); });
+    for (std::size_t i = 0; i < SIZE; ++i) {
+        ASSERT_EQ(hits[i].load(), 1) << i;
+    }
+
+    // Elements are passed by reference, grain of one element.
+    auto values = std::vector<int>(1000, 1);
+    exec::parallel_for(pool, values, [](int &val) { val *= 2; }, 1);
+    EXPECT_EQ(std::accumulate(values.begin(), values.end(), 0), 2000);
+
+    exec::parallel_for(pool, std::vector<int>(), [](int) { FAIL(); });
+}
+
+TEST(Parallel, Reduce) {
+    auto pool = builder::blank().max_workers(4).init_workers(4).build();
+    auto values = std::vector<std::int64_t>(100000);
+    std::iota(values.begin(), values.end(), 1);
+
+    EXPECT_EQ(exec::parallel_reduce(pool, values, std::int64_t(0)),
+              std::int64_t(5000050000));
+    EXPECT_EQ(exec::parallel_reduce(pool, std::vector<int>(), 7), 7);
+
+    auto squares = exec::transform_reduce(
+        pool, std::views::iota(1, 1001), std::int64_t(1), std::plus<>(),
+        [](int val) { return std::int64_t(val) * val; }, 16);
+    EXPECT_EQ(squares, 333833501);
+}
+
+TEST(Parallel, Error) {
+    auto pool = builder::blank().max_workers(2).init_workers(2).build();
+
+    EXPECT_THROW(exec::parallel_for(pool, std::views::iota(0, 10000),
+                                    [](int idx) {
+                                        if (idx == 5000) {
+                                            throw std::runtime_error("bad");
+                                        }
+                                    }),
+                 std::runtime_error);
+
+    // The pool is still usable.
+    EXPECT_EQ(exec::parallel_reduce(pool, std::views::iota(0, 100), 0), 4950);
+}
+
+TEST(Parallel, Nested) {
+    // Every worker waits on an inner loop, waiting workers run the pieces.
+    auto pool = builder::blank().max_workers(2).init_workers(2).build();
+    auto total = std::atomic_int64_t(0);
+
+    exec::parallel_for(
+        pool, std::views::iota(0, 16),
+        [&](int) {
+            total.fetch_add(exec::parallel_reduce(
+                pool, std::views::iota(0, 1000), std::int64_t(0),
+                std::plus<>(), 8));
+        },
+        1);
+    EXPECT_EQ(total.load(), 16 * 499500);
+}
+
+} // namespace
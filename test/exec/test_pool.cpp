@@ -1,11 +1,29 @@
 #include "nexus/exec/thread.hpp"
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
 #include <gtest/gtest.h>
+#include <latch>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+    #include <pthread.h>
+    #include <sched.h>
+#endif
 
 namespace {
 
 namespace builder = nexus::exec::thread_builder;
 
+using nexus::exec::IdlePolicy;
+using nexus::exec::TaskPolicy;
+
 template <typename T> auto unwrap_future(std::future<std::any> &fut) -> T {
     auto result = fut.get();
     return std::any_cast<T>(result);
@@ -48,4 +66,475 @@ TEST(Pool, ResizePool) {
     EXPECT_EQ(unwrap_future<int>(task6_future), 6);
 }
 
+TEST(Pool, Submit) {
+    auto pool = builder::common().build();
+
+    auto base = std::string("nexus");
+    auto int_future = pool.submit([](int lhs, int rhs) { return lhs + rhs; },
+                                  1, 2);
+    auto str_future = pool.submit(
+        [](const std::string &str) { return str + "::exec"; }, base);
+    auto void_future = pool.submit([]() {});
+    auto err_future =
+        pool.submit([]() -> int { throw std::runtime_error("exception"); });
+
+    EXPECT_EQ(int_future.get(), 3);
+    EXPECT_EQ(str_future.get(), "nexus::exec");
+    EXPECT_NO_THROW(void_future.get());
+    EXPECT_THROW(err_future.get(), std::runtime_error);
+
+    // Mutable functions and reference parameters bind to the stored copies.
+    auto mut_future = pool.submit([cnt = 0]() mutable { return ++cnt; });
+    auto ref_future = pool.submit(
+        [](std::string &str) { return str.append("::ref"); }, base);
+
+    EXPECT_EQ(mut_future.get(), 1);
+    EXPECT_EQ(ref_future.get(), "nexus::ref");
+    EXPECT_EQ(base, "nexus");
+}
+
+TEST(Pool, PushBulk) {
+    constexpr static int TASK_CNT = 64;
+
+    for (auto policy :
+         {TaskPolicy::FIFO, TaskPolicy::RING, TaskPolicy::STEAL}) {
+        // Small capacity, a bulk push must not fill RING before waking workers.
+        auto pool = builder::common().policy(policy).capacity(8).build();
+
+        auto tasks = std::vector<nexus::exec::Task<>>();
+        for (int i = 0; i < TASK_CNT; ++i) {
+            tasks.emplace_back([i]() { return i; });
+        }
+
+        auto futs = pool.push_bulk(tasks);
+        for (int i = 0; i < TASK_CNT; ++i) {
+            EXPECT_EQ(unwrap_future<int>(futs[i]), i);
+        }
+    }
+}
+
+TEST(Pool, BatchSize) {
+    constexpr static int TASK_CNT = 1024;
+
+    for (auto policy :
+         {TaskPolicy::FIFO, TaskPolicy::RING, TaskPolicy::STEAL}) {
+        auto pool = builder::common().policy(policy).batch_size(16).build();
+
+        auto futs = std::vector<std::future<int>>();
+        for (int i = 0; i < TASK_CNT; ++i) {
+            futs.push_back(pool.submit([i]() { return i; }));
+        }
+
+        for (int i = 0; i < TASK_CNT; ++i) {
+            EXPECT_EQ(futs[i].get(), i);
+        }
+    }
+}
+
+TEST(Pool, IdlePolicy) {
+    using namespace std::chrono_literals;
+    constexpr static int BURST_CNT = 8;
+    constexpr static int TASK_CNT = 64;
+
+    for (auto idle :
+         {IdlePolicy::Block, IdlePolicy::Spin, IdlePolicy::Adaptive}) {
+        auto pool = builder::common().idle_policy(idle).spin_count(256).build();
+
+        // Bursts with a lull between them, workers go idle in between.
+        for (int burst = 0; burst < BURST_CNT; ++burst) {
+            auto futs = std::vector<std::future<int>>();
+            for (int i = 0; i < TASK_CNT; ++i) {
+                futs.push_back(pool.submit([i]() { return i; }));
+            }
+
+            for (int i = 0; i < TASK_CNT; ++i) {
+                EXPECT_EQ(futs[i].get(), i);
+            }
+
+            std::this_thread::sleep_for(1ms);
+        }
+    }
+
+    // Round trips with a short lull: a blocking worker parks after each task,
+    // a spinning one catches the next task before parking.
+    constexpr static int TRIP_CNT = 64;
+    auto parks = [](IdlePolicy idle) {
+        auto pool = builder::blank()
+                        .max_workers(1)
+                        .init_workers(1)
+                        .idle_policy(idle)
+                        .spin_count(1 << 20)
+                        .build();
+        for (int i = 0; i < TRIP_CNT; ++i) {
+            pool.submit([]() {}).get();
+            std::this_thread::sleep_for(200us);
+        }
+        return pool.report().metrics.parks;
+    };
+
+    auto block = parks(IdlePolicy::Block);
+    EXPECT_GE(block, TRIP_CNT / 2);
+    EXPECT_LT(parks(IdlePolicy::Spin), block / 4);
+    EXPECT_LT(parks(IdlePolicy::Adaptive), block / 4);
+}
+
+TEST(Pool, AutoScale) {
+    using namespace std::chrono_literals;
+    constexpr static int TASK_CNT = 64;
+    constexpr static std::size_t MAX_WORKERS = 8;
+
+    auto scale = nexus::exec::ThreadPool::AutoScale();
+    scale.enabled = true;
+    scale.interval = 1ms;
+    scale.grow_depth = 2;
+    scale.keep_alive = 50ms;
+
+    auto pool = builder::blank()
+                    .max_workers(MAX_WORKERS)
+                    .min_workers(1)
+                    .init_workers(1)
+                    .autoscale(scale)
+                    .build();
+
+    // A backlog of slow tasks grows the pool.
+    auto futs = std::vector<std::future<int>>();
+    for (int i = 0; i < TASK_CNT; ++i) {
+        futs.push_back(pool.submit([i]() {
+            std::this_thread::sleep_for(1ms);
+            return i;
+        }));
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (pool.report().running == 1 &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(1ms);
+    }
+    EXPECT_GT(pool.report().running, 1);
+    EXPECT_LE(pool.report().running, MAX_WORKERS);
+
+    for (int i = 0; i < TASK_CNT; ++i) {
+        EXPECT_EQ(futs[i].get(), i);
+    }
+
+    // Idle workers are removed after keep_alive.
+    deadline = std::chrono::steady_clock::now() + 5s;
+    while (pool.report().running > 1 &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(1ms);
+    }
+    EXPECT_EQ(pool.report().running, 1);
+}
+
+TEST(Pool, Histogram) {
+    auto hist = nexus::exec::Histogram();
+    EXPECT_EQ(hist.percentile(50), 0);
+
+    for (std::uint64_t i = 1; i <= 1000; ++i) {
+        hist.record(i * 1000);
+    }
+
+    EXPECT_EQ(hist.count(), 1000);
+    EXPECT_EQ(hist.min(), 1000);
+    EXPECT_EQ(hist.max(), 1000000);
+    EXPECT_DOUBLE_EQ(hist.mean(), 500500.0);
+    EXPECT_EQ(hist.percentile(100), 1000000);
+
+    // Within one sub bucket of the exact value.
+    for (auto pct : {1.0, 50.0, 90.0, 99.0}) {
+        auto exact = static_cast<double>(pct * 10 * 1000);
+        auto value = static_cast<double>(hist.percentile(pct));
+        EXPECT_GE(value, exact);
+        EXPECT_LE(value, exact * (1.0 + (1.0 / hist.SUB_BUCKETS)));
+    }
+
+    // Buckets cover the whole range without gaps.
+    for (std::size_t i = 1; i < hist.BUCKETS; ++i) {
+        EXPECT_EQ(nexus::exec::Histogram::bucket(
+                      nexus::exec::Histogram::bucket_max(i - 1) + 1),
+                  i);
+    }
+    EXPECT_EQ(nexus::exec::Histogram::bucket(UINT64_MAX), hist.BUCKETS - 1);
+
+    auto other = nexus::exec::Histogram();
+    other.record(7, 3);
+    hist.merge(other);
+    EXPECT_EQ(hist.count(), 1003);
+    EXPECT_EQ(hist.min(), 7);
+}
+
+TEST(Pool, Metrics) {
+    using namespace std::chrono_literals;
+    constexpr static int TASK_CNT = 256;
+    constexpr static std::size_t WORKER_CNT = 4;
+
+    auto pool = builder::blank()
+                    .max_workers(WORKER_CNT)
+                    .init_workers(WORKER_CNT)
+                    .build();
+
+    auto futs = std::vector<std::future<int>>();
+    for (int i = 0; i < TASK_CNT; ++i) {
+        futs.push_back(pool.submit([i]() {
+            if (i % 64 == 0) {
+                std::this_thread::sleep_for(1ms);
+            }
+            return i;
+        }));
+    }
+
+    for (auto &fut : futs) {
+        fut.get();
+    }
+
+    // The future is ready before the worker updates its counters.
+    auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (pool.report().metrics.executed != TASK_CNT &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(1ms);
+    }
+
+    auto metrics = pool.report().metrics;
+    EXPECT_EQ(metrics.executed, TASK_CNT);
+    EXPECT_EQ(metrics.wait.count(), TASK_CNT);
+    EXPECT_EQ(metrics.run.count(), TASK_CNT);
+    EXPECT_GE(metrics.run.max(), 1000000);
+    EXPECT_GT(metrics.peak_depth, 0);
+    EXPECT_EQ(metrics.depth, 0);
+    EXPECT_GT(metrics.throughput(), 0.0);
+
+    ASSERT_EQ(metrics.workers.size(), WORKER_CNT);
+    std::uint64_t executed = 0;
+    for (const auto &worker : metrics.workers) {
+        executed += worker.executed;
+    }
+    EXPECT_EQ(executed, TASK_CNT);
+
+    // Removed workers are still counted.
+    pool.resize_workers(1);
+    auto shrunk = pool.report().metrics;
+    EXPECT_EQ(shrunk.executed, TASK_CNT);
+    EXPECT_EQ(shrunk.run.count(), TASK_CNT);
+}
+
+#ifdef __linux__
+TEST(Pool, ThreadOptions) {
+    constexpr static std::size_t STACK_SIZE = 1024 * 1024;
+
+    auto pool = builder::blank()
+                    .init_workers(1)
+                    .cpus({0})
+                    .stack_size(STACK_SIZE)
+                    .name_prefix("nexus-test-")
+                    .build();
+
+    auto name = pool.submit([]() {
+                        auto buf = std::array<char, 16>();
+                        pthread_getname_np(pthread_self(), buf.data(),
+                                           buf.size());
+                        return std::string(buf.data());
+                    }).get();
+    EXPECT_EQ(name, "nexus-test-0");
+
+    auto cpus = pool.submit([]() {
+                        cpu_set_t set;
+                        CPU_ZERO(&set);
+                        sched_getaffinity(0, sizeof(set), &set);
+                        return CPU_COUNT(&set) == 1 && CPU_ISSET(0, &set);
+                    }).get();
+    EXPECT_TRUE(cpus);
+
+    auto stack = pool.submit([]() {
+                         pthread_attr_t attr;
+                         std::size_t    size = 0;
+                         pthread_getattr_np(pthread_self(), &attr);
+                         pthread_attr_getstacksize(&attr, &size);
+                         pthread_attr_destroy(&attr);
+                         return size;
+                     }).get();
+    EXPECT_GE(stack, STACK_SIZE);
+}
+#endif
+
+TEST(Pool, Post) {
+    constexpr static int TASK_CNT = 16;
+
+    auto done = std::latch(TASK_CNT + 1);
+    auto sum = std::atomic_int(0);
+    auto pool = builder::common()
+                    .error_handler([&done](std::exception_ptr err) {
+                        EXPECT_THROW(std::rethrow_exception(err),
+                                     std::runtime_error);
+                        done.count_down();
+                    })
+                    .build();
+
+    for (int i = 0; i < TASK_CNT; ++i) {
+        pool.post(
+            [&done, &sum](int num) {
+                sum.fetch_add(num);
+                done.count_down();
+            },
+            1);
+    }
+    pool.post([]() { throw std::runtime_error("exception"); });
+
+    done.wait();
+    EXPECT_EQ(sum.load(), TASK_CNT);
+}
+
+TEST(Pool, PostResult) {
+    constexpr static int TASK_CNT = 16;
+
+    auto done = std::latch(TASK_CNT);
+    auto sum = std::atomic_int(0);
+    auto pool = builder::common().build();
+
+    for (int i = 0; i < TASK_CNT; ++i) {
+        pool.post(
+            [&done, &sum](int num) {
+                sum.fetch_add(num);
+                done.count_down();
+                return num;
+            },
+            1);
+    }
+
+    done.wait();
+    EXPECT_EQ(sum.load(), TASK_CNT);
+}
+
+TEST(Pool, Deadline) {
+    using namespace std::chrono_literals;
+    using nexus::exec::MissPolicy;
+    using TaskType = nexus::exec::ThreadPool::TaskType;
+
+    auto handled = std::atomic_int(0);
+    auto pool = builder::blank()
+                    .policy(TaskPolicy::EDF)
+                    .max_workers(1)
+                    .init_workers(1)
+                    .miss_policy(MissPolicy::Handle,
+                                 [&handled](TaskType &&task) {
+                                     (void)task;
+                                     handled.fetch_add(1);
+                                 })
+                    .build();
+
+    // Hold the worker, so the queue orders the tasks below.
+    auto gate = std::latch(1);
+    pool.post([&gate]() { gate.wait(); });
+
+    auto order = std::vector<int>();
+    auto make = [&order](int value, std::chrono::steady_clock::time_point at,
+                         std::chrono::milliseconds sleep = 0ms) {
+        auto task = TaskType([&order, value, sleep]() {
+            std::this_thread::sleep_for(sleep);
+            order.push_back(value);
+            return value;
+        });
+        task.deadline(at);
+        return task;
+    };
+
+    auto now = std::chrono::steady_clock::now();
+    auto late = pool.push(make(1, now + 200ms, 250ms));
+    auto missed = pool.push(make(-1, now - 1ms));
+    auto last = pool.push(make(2, now + 1h));
+    gate.count_down();
+
+    late.get();
+    last.get();
+    EXPECT_THROW(missed.get(), std::future_error);
+    EXPECT_EQ(order, (std::vector<int>{1, 2}));
+    EXPECT_EQ(handled.load(), 1);
+
+    auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (pool.report().metrics.late == 0 &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(1ms);
+    }
+    auto metrics = pool.report().metrics;
+    EXPECT_EQ(metrics.misses, 1);
+    EXPECT_EQ(metrics.late, 1);
+
+    // Dropped tasks break their futures.
+    auto drop = builder::blank()
+                    .policy(TaskPolicy::EDF)
+                    .max_workers(1)
+                    .init_workers(1)
+                    .miss_policy(MissPolicy::Drop)
+                    .build();
+    auto dropped = drop.push(make(-1, now - 1ms));
+    EXPECT_THROW(dropped.get(), std::future_error);
+}
+
+TEST(Pool, StealPolicy) {
+    constexpr static int SPAWN_CNT = 64;
+
+    auto pool = builder::common().policy(TaskPolicy::STEAL).build();
+    pool.resize_workers(4);
+
+    // Tasks spawned inside workers go to local deques and get stolen.
+    auto done = std::latch(SPAWN_CNT * SPAWN_CNT);
+    auto sum = std::atomic_int(0);
+    for (int i = 0; i < SPAWN_CNT; ++i) {
+        pool.emplace([&pool, &done, &sum]() {
+            for (int j = 0; j < SPAWN_CNT; ++j) {
+                pool.emplace([&done, &sum]() {
+                    auto res = sum.fetch_add(1);
+                    done.count_down();
+                    return res;
+                });
+            }
+            return 0;
+        });
+    }
+
+    done.wait();
+    EXPECT_EQ(sum.load(), SPAWN_CNT * SPAWN_CNT);
+}
+
+TEST(Pool, RingPolicy) {
+    constexpr static int TASK_CNT = 1024;
+
+    // Small ring, producer has to wait for free cells.
+    auto pool = builder::common().policy(TaskPolicy::RING).capacity(8).build();
+
+    auto futs = std::vector<std::future<std::any>>();
+    for (int i = 0; i < TASK_CNT; ++i) {
+        futs.push_back(pool.emplace([i]() { return i; }));
+    }
+
+    for (int i = 0; i < TASK_CNT; ++i) {
+        EXPECT_EQ(unwrap_future<int>(futs[i]), i);
+    }
+}
+
+// A worker posting to its own full ring runs queued tasks instead of spinning.
+TEST(Pool, RingWorkerPush) {
+    constexpr static int TASK_CNT = 1024;
+
+    auto pool = builder::blank()
+                    .policy(TaskPolicy::RING)
+                    .capacity(8)
+                    .max_workers(1)
+                    .init_workers(1)
+                    .build();
+
+    auto done = std::latch(TASK_CNT);
+    auto sum = std::atomic_int(0);
+    pool.post([&pool, &done, &sum]() {
+        for (int i = 0; i < TASK_CNT; ++i) {
+            pool.post([&done, &sum]() {
+                sum.fetch_add(1);
+                done.count_down();
+            });
+        }
+    });
+
+    done.wait();
+    EXPECT_EQ(sum.load(), TASK_CNT);
+}
+
 } // namespace
@@ -3,13 +3,19 @@
 #include "nexus/exec/task.hpp"
 
 #include <any>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <gtest/gtest.h>
+#include <thread>
+#include <vector>
 
 namespace {
 
 using nexus::exec::Task;
 using nexus::exec::TaskPolicy;
 using nexus::exec::TaskQueue;
+using nexus::exec::detail::Parker;
 
 template <typename T> auto unwrap_task(Task<std::any> &task) -> T {
     task();
@@ -76,6 +82,55 @@ TEST(TaskQueue, PRIO) {
     EXPECT_EQ(unwrap_task<int>(task3), 2);
 }
 
+TEST(TaskQueue, PRIOStable) {
+    auto prio = TaskQueue(TaskPolicy::PRIO);
+
+    // Same priority keeps push order, extreme priorities are valid.
+    for (int i = 0; i < 32; ++i) {
+        auto task = Task<>([i]() { return i; });
+        task.prio(static_cast<int8_t>(i % 2 == 0 ? -128 : 127));
+        prio.push(std::move(task));
+    }
+
+    for (int i = 1; i < 32; i += 2) {
+        auto task = prio.pop();
+        EXPECT_EQ(task.prio(), 127);
+        EXPECT_EQ(unwrap_task<int>(task), i);
+    }
+
+    for (int i = 0; i < 32; i += 2) {
+        auto task = prio.pop();
+        EXPECT_EQ(task.prio(), -128);
+        EXPECT_EQ(unwrap_task<int>(task), i);
+    }
+
+    EXPECT_TRUE(prio.empty());
+}
+
+TEST(TaskQueue, EDF) {
+    auto edf = TaskQueue(TaskPolicy::EDF);
+    auto now = std::chrono::steady_clock::now();
+
+    // Tasks without deadline go last, equal deadlines keep push order.
+    auto push = [&edf](int value, std::chrono::steady_clock::time_point at) {
+        auto task = Task<>([value]() { return value; });
+        task.deadline(at);
+        edf.push(std::move(task));
+    };
+    push(4, Task<>::NO_DEADLINE);
+    push(2, now + std::chrono::milliseconds(20));
+    push(0, now + std::chrono::milliseconds(10));
+    push(3, now + std::chrono::milliseconds(30));
+    push(1, now + std::chrono::milliseconds(10));
+    push(5, Task<>::NO_DEADLINE);
+
+    for (int i = 0; i < 6; ++i) {
+        auto task = edf.pop();
+        EXPECT_EQ(unwrap_task<int>(task), i);
+    }
+    EXPECT_TRUE(edf.empty());
+}
+
 TEST(TaskQueue, RAND) {
     auto rand = TaskQueue(TaskPolicy::RAND);
 
@@ -94,4 +149,169 @@ TEST(TaskQueue, RAND) {
     EXPECT_EQ(res, 3);
 }
 
+TEST(TaskQueue, RANDConcurrent) {
+    constexpr static int THREAD_CNT = 4;
+    constexpr static int TASK_CNT = 1000;
+
+    auto rand = TaskQueue(TaskPolicy::RAND, THREAD_CNT);
+    auto sum = std::atomic_int(0);
+
+    {
+        auto threads = std::vector<std::jthread>();
+        for (int i = 0; i < THREAD_CNT; ++i) {
+            threads.emplace_back([&rand]() {
+                for (int j = 0; j < TASK_CNT; ++j) {
+                    rand.emplace([]() { return 1; });
+                }
+            });
+            threads.emplace_back([&rand, &sum]() {
+                for (int j = 0; j < TASK_CNT; ++j) {
+                    auto task = rand.pop();
+                    sum += unwrap_task<int>(task);
+                }
+            });
+        }
+    }
+
+    EXPECT_EQ(sum.load(), THREAD_CNT * TASK_CNT);
+    EXPECT_TRUE(rand.empty());
+}
+
+TEST(TaskQueue, PushBulk) {
+    auto fifo = TaskQueue(TaskPolicy::FIFO);
+
+    auto tasks = std::vector<Task<>>();
+    tasks.emplace_back([]() { return 0; });
+    tasks.emplace_back([]() { return 1; });
+    tasks.emplace_back([]() { return 2; });
+
+    fifo.push_bulk(tasks);
+    EXPECT_EQ(fifo.size(), 3);
+
+    auto task1 = fifo.pop();
+    auto task2 = fifo.pop();
+    auto task3 = fifo.pop();
+
+    EXPECT_EQ(unwrap_task<int>(task1), 0);
+    EXPECT_EQ(unwrap_task<int>(task2), 1);
+    EXPECT_EQ(unwrap_task<int>(task3), 2);
+}
+
+TEST(TaskQueue, PopBulk) {
+    auto fifo = TaskQueue(TaskPolicy::FIFO);
+    auto batch = std::vector<Task<>>();
+    auto never = []() { return false; };
+
+    for (int i = 0; i < 8; ++i) {
+        fifo.emplace([i]() { return i; });
+    }
+
+    // Bounded by batch size.
+    EXPECT_EQ(fifo.pop_bulk(batch, 4, never), 4);
+    EXPECT_EQ(unwrap_task<int>(batch[0]), 0);
+    EXPECT_EQ(unwrap_task<int>(batch[3]), 3);
+    batch.clear();
+
+    // Bounded by fair share, 4 tasks left for 2 workers.
+    fifo.attach();
+    fifo.attach();
+    EXPECT_EQ(fifo.pop_bulk(batch, 4, never), 2);
+    EXPECT_EQ(unwrap_task<int>(batch[0]), 4);
+    fifo.detach();
+    fifo.detach();
+
+    EXPECT_EQ(fifo.size(), 2);
+    EXPECT_EQ(fifo.pop_bulk(batch, 4, []() { return true; }), 0);
+}
+
+TEST(TaskQueue, Unpark) {
+    using namespace std::chrono_literals;
+
+    for (auto policy : {TaskPolicy::FIFO, TaskPolicy::RING}) {
+        auto queue = TaskQueue(policy);
+
+        auto lhs_parker = Parker();
+        auto rhs_parker = Parker();
+        auto lhs_stop = std::atomic_bool(false);
+        auto rhs_stop = std::atomic_bool(false);
+        auto lhs_done = std::atomic_bool(false);
+        auto rhs_done = std::atomic_bool(false);
+
+        auto waiter = [&queue](Parker &parker, std::atomic_bool &stop,
+                               std::atomic_bool &done) {
+            return std::jthread([&queue, &parker, &stop, &done]() {
+                queue.pop([&stop]() { return stop.load(); }, parker);
+                done.store(true);
+            });
+        };
+
+        auto lhs = waiter(lhs_parker, lhs_stop, lhs_done);
+        auto rhs = waiter(rhs_parker, rhs_stop, rhs_done);
+        std::this_thread::sleep_for(10ms);
+
+        // Only the unparked waiter re-checks its pred.
+        lhs_stop.store(true);
+        queue.unpark(lhs_parker);
+        lhs.join();
+        EXPECT_TRUE(lhs_done.load());
+
+        std::this_thread::sleep_for(10ms);
+        EXPECT_FALSE(rhs_done.load());
+
+        // A push wakes the other one.
+        queue.emplace([]() { return 0; });
+        rhs.join();
+        EXPECT_TRUE(rhs_done.load());
+        EXPECT_TRUE(queue.empty());
+    }
+}
+
+TEST(TaskQueue, RING) {
+    auto ring = TaskQueue(TaskPolicy::RING, TaskQueue::DEFAULT_WORKERS, 2);
+
+    ring.emplace([]() { return 0; });
+    ring.emplace([]() { return 1; });
+
+    auto task1 = ring.pop();
+
+    // Cells are reused after a full lap.
+    ring.emplace([]() { return 2; });
+
+    auto task2 = ring.pop();
+    auto task3 = ring.pop();
+
+    EXPECT_EQ(unwrap_task<int>(task1), 0);
+    EXPECT_EQ(unwrap_task<int>(task2), 1);
+    EXPECT_EQ(unwrap_task<int>(task3), 2);
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(TaskQueue, STEAL) {
+    auto steal = TaskQueue(TaskPolicy::STEAL);
+
+    // Not attached, tasks go to the injection queue.
+    steal.emplace([]() { return 0; });
+
+    // Attached, tasks go to the local deque and are popped first in LIFO
+    // order.
+    EXPECT_TRUE(steal.attach());
+    steal.emplace([]() { return 1; });
+    steal.emplace([]() { return 2; });
+
+    auto task1 = steal.pop();
+    auto task2 = steal.pop();
+    auto task3 = steal.pop();
+
+    // Local tasks are moved to the injection queue on detach.
+    steal.emplace([]() { return 3; });
+    steal.detach();
+    auto task4 = steal.pop();
+
+    EXPECT_EQ(unwrap_task<int>(task1), 2);
+    EXPECT_EQ(unwrap_task<int>(task2), 1);
+    EXPECT_EQ(unwrap_task<int>(task3), 0);
+    EXPECT_EQ(unwrap_task<int>(task4), 3);
+    EXPECT_TRUE(steal.empty());
+}
+
 } // namespace
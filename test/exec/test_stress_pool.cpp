@@ -1,17 +1,23 @@
 #include "nexus/exec/thread.hpp"
 
+#include <algorithm>
 #include <any>
+#include <array>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <exception>
 #include <format>
 #include <future>
+#include <iomanip>
 #include <iostream>
 #include <optional>
+#include <random>
 #include <span>
 #include <string>
 #include <string_view>
 #include <thread>
+#include <utility>
 #include <vector>
 
 namespace {
@@ -20,11 +26,39 @@ enum class BuilderType : uint8_t { Common, CpuBound, IOBound, Time };
 
 enum class TaskType : uint8_t { Sleep, TinyLoop, MidLoop, LargeLoop };
 
+enum class SubmitType : uint8_t { Single, Bulk };
+
+/**
+ * @brief Throughput submits everything then waits (closed loop). Latency does
+ * the same and records per task timestamps. Fixed and Poisson submit at a
+ * given rate (open loop), latency is measured from the scheduled submit time,
+ * so a stalled submitter does not hide queueing (coordinated omission).
+ *
+ */
+enum class Mode : uint8_t { Throughput, Latency, Fixed, Poisson };
+
 struct TestArgs {
-    BuilderType builder;
-    TaskType    task_type;
-    std::size_t task_cnt;
-    std::size_t thread_cnt;
+    BuilderType             builder;
+    TaskType                task_type;
+    std::size_t             task_cnt;
+    std::size_t             thread_cnt;
+    nexus::exec::TaskPolicy policy;
+    SubmitType              submit;
+    Mode                    mode;
+    double                  rate; // Tasks per second of open loop modes.
+};
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Timestamps of one task, `intended` is the scheduled submit time.
+ *
+ */
+struct Sample {
+    Clock::time_point intended;
+    Clock::time_point submit;
+    Clock::time_point start;
+    Clock::time_point finish;
 };
 
 auto null_tester() -> std::size_t { return 0ULL; }
@@ -102,11 +136,97 @@ auto parse_task_type(std::string_view str) -> std::optional<TaskType> {
     return {};
 }
 
+auto parse_policy(std::string_view str)
+    -> std::optional<nexus::exec::TaskPolicy> {
+    using nexus::exec::TaskPolicy;
+
+    if (str == "fifo") {
+        return TaskPolicy::FIFO;
+    }
+
+    if (str == "lifo") {
+        return TaskPolicy::LIFO;
+    }
+
+    if (str == "prio") {
+        return TaskPolicy::PRIO;
+    }
+
+    if (str == "rand") {
+        return TaskPolicy::RAND;
+    }
+
+    if (str == "steal") {
+        return TaskPolicy::STEAL;
+    }
+
+    if (str == "ring") {
+        return TaskPolicy::RING;
+    }
+
+    if (str == "edf") {
+        return TaskPolicy::EDF;
+    }
+
+    return {};
+}
+
+auto parse_submit_type(std::string_view str) -> std::optional<SubmitType> {
+    if (str == "single") {
+        return SubmitType::Single;
+    }
+
+    if (str == "bulk") {
+        return SubmitType::Bulk;
+    }
+
+    return {};
+}
+
+/**
+ * @brief Parse mode, `throughput`, `latency`, `fixed:<rate>` or
+ * `poisson:<rate>`.
+ *
+ */
+auto parse_mode(std::string_view str)
+    -> std::optional<std::pair<Mode, double>> {
+    if (str == "throughput") {
+        return std::pair(Mode::Throughput, 0.0);
+    }
+
+    if (str == "latency") {
+        return std::pair(Mode::Latency, 0.0);
+    }
+
+    auto sep = str.find(':');
+    if (sep == std::string_view::npos) {
+        return {};
+    }
+
+    auto name = str.substr(0, sep);
+    auto mode = Mode::Fixed;
+    if (name == "poisson") {
+        mode = Mode::Poisson;
+    } else if (name != "fixed") {
+        return {};
+    }
+
+    try {
+        auto rate = std::stod(std::string(str.substr(sep + 1)));
+        if (rate <= 0) {
+            return {};
+        }
+        return std::pair(mode, rate);
+    } catch (std::exception & /*err*/) {
+        return {};
+    }
+}
+
 auto parse_args(const std::span<char *> &args) -> std::optional<TestArgs> {
     if (args.size() < 5) { // NOLINT
-        std::cerr << std::format(
-            "Usage: {} <builder> <task_type> <task_cnt> <thread_cnt>\n",
-            args[0]);
+        std::cerr << std::format("Usage: {} <builder> <task_type> <task_cnt> "
+                                 "<thread_cnt> [policy] [submit] [mode]\n",
+                                 args[0]);
         return {};
     }
 
@@ -139,10 +259,51 @@ auto parse_args(const std::span<char *> &args) -> std::optional<TestArgs> {
         return {};
     }
 
+    auto policy_result = std::optional(nexus::exec::TaskPolicy::FIFO);
+    if (args.size() > 5) { // NOLINT
+        policy_result = parse_policy(args[5]);
+        if (!policy_result.has_value()) {
+            std::cerr << std::format("Error: {} is not a valid policy\n",
+                                     args[5]);
+            return {};
+        }
+    }
+
+    auto submit_result = std::optional(SubmitType::Single);
+    if (args.size() > 6) { // NOLINT
+        submit_result = parse_submit_type(args[6]);
+        if (!submit_result.has_value()) {
+            std::cerr << std::format("Error: {} is not a valid submit type\n",
+                                     args[6]);
+            return {};
+        }
+    }
+
+    auto mode_result = std::optional(std::pair(Mode::Throughput, 0.0));
+    if (args.size() > 7) { // NOLINT
+        mode_result = parse_mode(args[7]);
+        if (!mode_result.has_value()) {
+            std::cerr << std::format("Error: {} is not a valid mode\n",
+                                     args[7]);
+            return {};
+        }
+    }
+
+    auto [mode, rate] = mode_result.value();
+    if (submit_result.value() == SubmitType::Bulk &&
+        (mode == Mode::Fixed || mode == Mode::Poisson)) {
+        std::cerr << "Error: bulk submit only supports closed loop modes\n";
+        return {};
+    }
+
     return TestArgs{.builder = builder_type_result.value(),
                     .task_type = task_type_result.value(),
                     .task_cnt = task_cnt,
-                    .thread_cnt = thread_cnt};
+                    .thread_cnt = thread_cnt,
+                    .policy = policy_result.value(),
+                    .submit = submit_result.value(),
+                    .mode = mode,
+                    .rate = rate};
 }
 
 auto get_builder(BuilderType type) {
@@ -167,6 +328,99 @@ auto get_tester(TaskType type) {
     }
 }
 
+/**
+ * @brief Get scheduled submit times of open loop modes, evenly spaced (Fixed)
+ * or with exponential gaps (Poisson).
+ *
+ */
+auto schedule(const TestArgs &args, Clock::time_point start)
+    -> std::vector<Clock::time_point> {
+    auto res = std::vector<Clock::time_point>(args.task_cnt, start);
+
+    // Fixed seed, runs are comparable.
+    auto rng = std::mt19937_64(args.task_cnt); // NOLINT
+    auto gap = std::exponential_distribution<double>(args.rate);
+
+    auto offset = 0.0;
+    for (std::size_t i = 0; i < args.task_cnt; ++i) {
+        res[i] = start + std::chrono::duration_cast<Clock::duration>(
+                             std::chrono::duration<double>(offset));
+        offset += args.mode == Mode::Poisson ? gap(rng) : 1.0 / args.rate;
+    }
+
+    return res;
+}
+
+/**
+ * @brief Wait until `time`, sleep while it is far and spin at the end.
+ *
+ */
+auto wait_until(Clock::time_point time) -> void {
+    using namespace std::chrono_literals;
+    constexpr static auto SPIN_TIME = 100us;
+
+    auto now = Clock::now();
+    if (time - now > SPIN_TIME) {
+        std::this_thread::sleep_until(time - SPIN_TIME);
+    }
+
+    while (Clock::now() < time) {
+        std::this_thread::yield();
+    }
+}
+
+/**
+ * @brief Print percentiles of durations in microseconds.
+ *
+ */
+auto print_percentiles(std::string_view name,
+                       std::vector<Clock::duration> &durations) -> void {
+    constexpr static auto PERCENTILES = std::array{50.0, 90.0, 99.0, 99.9};
+    constexpr static int  WIDTH = 10;
+
+    std::ranges::sort(durations);
+
+    auto to_us = [](Clock::duration dur) {
+        return std::chrono::duration<double, std::micro>(dur).count();
+    };
+
+    std::cout << "  " << name;
+    for (auto pct : PERCENTILES) {
+        auto rank = static_cast<std::size_t>(
+            pct / 100.0 * static_cast<double>(durations.size() - 1));
+        std::cout << std::setw(WIDTH) << to_us(durations[rank]);
+    }
+    std::cout << std::setw(WIDTH) << to_us(durations.back()) << '\n';
+}
+
+/**
+ * @brief Print queue wait (submit to start) and end to end latency
+ * (scheduled submit to finish).
+ *
+ */
+auto print_latency(const std::vector<Sample> &samples) -> void {
+    if (samples.empty()) {
+        return;
+    }
+
+    auto wait = std::vector<Clock::duration>();
+    auto total = std::vector<Clock::duration>();
+    wait.reserve(samples.size());
+    total.reserve(samples.size());
+    for (const auto &sample : samples) {
+        wait.push_back(sample.start - sample.submit);
+        total.push_back(sample.finish - sample.intended);
+    }
+
+    std::cout << "Latency (us):\n";
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "         " << "       p50       p90       p99     p99.9"
+              << "       max\n";
+    print_percentiles("Wait : ", wait);
+    print_percentiles("Total: ", total);
+    std::cout << std::defaultfloat;
+}
+
 } // namespace
 
 auto main(int argc, char **argv) -> int {
@@ -183,15 +437,57 @@ auto main(int argc, char **argv) -> int {
 
     // Build pool
     auto builder = get_builder(args.builder);
-    auto pool = builder.build();
+    auto pool = builder.policy(args.policy).build();
     pool.resize_workers(args.thread_cnt);
 
+    auto timed = args.mode != Mode::Throughput;
+    auto samples = std::vector<Sample>(timed ? args.task_cnt : 0);
+
+    // Each task only touches its own sample, futures publish them.
+    auto timed_tester = [&samples, tester](std::size_t idx) {
+        samples[idx].start = Clock::now();
+        auto res = tester();
+        samples[idx].finish = Clock::now();
+        return res;
+    };
+
     // Time start
     auto start = std::chrono::high_resolution_clock::now();
 
     auto futs = std::vector<std::future<std::any>>(args.task_cnt);
-    for (std::size_t i = 0; i < args.task_cnt; ++i) {
-        futs[i] = pool.emplace(tester);
+    if (args.mode == Mode::Fixed || args.mode == Mode::Poisson) {
+        auto intended = schedule(args, Clock::now());
+        for (std::size_t i = 0; i < args.task_cnt; ++i) {
+            wait_until(intended[i]);
+            samples[i].intended = intended[i];
+            samples[i].submit = Clock::now();
+            futs[i] = pool.emplace(timed_tester, i);
+        }
+    } else if (args.submit == SubmitType::Bulk) {
+        auto tasks = std::vector<nexus::exec::Task<>>();
+        tasks.reserve(args.task_cnt);
+        for (std::size_t i = 0; i < args.task_cnt; ++i) {
+            if (timed) {
+                tasks.emplace_back(timed_tester, i);
+            } else {
+                tasks.emplace_back(tester);
+            }
+        }
+
+        auto submit = Clock::now();
+        for (auto &sample : samples) {
+            sample.intended = sample.submit = submit;
+        }
+        futs = pool.push_bulk(tasks);
+    } else {
+        for (std::size_t i = 0; i < args.task_cnt; ++i) {
+            if (timed) {
+                samples[i].submit = samples[i].intended = Clock::now();
+                futs[i] = pool.emplace(timed_tester, i);
+            } else {
+                futs[i] = pool.emplace(tester);
+            }
+        }
     }
 
     auto insert_end = std::chrono::high_resolution_clock::now();
@@ -211,10 +507,18 @@ auto main(int argc, char **argv) -> int {
     std::cout << "  Task   : " << args_str[2] << '\n';
     std::cout << "  Count  : " << args_str[3] << '\n';
     std::cout << "  Threads: " << args_str[4] << '\n';
+    std::cout << "  Policy : " << (args_str.size() > 5 ? args_str[5] : "fifo")
+              << '\n';
+    std::cout << "  Submit : " << (args_str.size() > 6 ? args_str[6] : "single")
+              << '\n';
+    std::cout << "  Mode   : "
+              << (args_str.size() > 7 ? args_str[7] : "throughput") << '\n';
     std::cout << "  Insert : " << insert_time.count() << " s\n";
     std::cout << "  Total  : " << total_time.count() << " s\n";
     std::cout << "  Tps    : " << (double)args.task_cnt / total_time.count()
               << " t/s\n";
     std::cout << "  Average: " << total_time.count() / (double)args.task_cnt
               << " s\n";
+
+    print_latency(samples);
 }
@@ -1,8 +1,11 @@
 #include "nexus/exec/task.hpp"
 
+#include <array>
 #include <future>
 #include <gtest/gtest.h>
+#include <memory>
 #include <stdexcept>
+#include <thread>
 
 namespace {
 
@@ -35,4 +38,48 @@ TEST(Task, Failed) {
     EXPECT_THROW(failed_task_future.get(), std::runtime_error);
 }
 
+TEST(Task, Detached) {
+    auto detached_task =
+        Task<>(nexus::exec::detail::TaskDetach(),
+               []() { throw std::runtime_error("exception"); });
+
+    EXPECT_TRUE(detached_task.detached());
+    EXPECT_THROW(detached_task.get_future(), std::future_error);
+    EXPECT_THROW(detached_task(), std::runtime_error);
+}
+
+TEST(Task, DetachedResult) {
+    auto called = 0;
+    auto detached_task = Task<>(nexus::exec::detail::TaskDetach(),
+                                [&called](int num) {
+                                    called = num;
+                                    return num;
+                                },
+                                3);
+
+    EXPECT_NO_THROW(detached_task());
+    EXPECT_EQ(called, 3);
+}
+
+TEST(Task, LargeCapture) {
+    auto data = std::array<int, 64>(); // NOLINT
+    data.back() = 42;                  // NOLINT
+
+    auto task = Task<int>([data]() { return data.back(); });
+    auto moved_task = std::move(task);
+    moved_task();
+
+    EXPECT_EQ(moved_task.get_future().get(), 42);
+}
+
+// Task blocks freed at thread exit after the task pool cache is destroyed.
+TEST(Task, ThreadExit) {
+    auto thread = std::thread([]() {
+        // Constructed before the cache, so destroyed after it.
+        thread_local auto held = std::unique_ptr<Task<int>>();
+        held = std::make_unique<Task<int>>([]() { return 1; });
+    });
+    thread.join();
+}
+
 } // namespace
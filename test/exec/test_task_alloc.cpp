@@ -0,0 +1,147 @@
+#include "nexus/exec/policy.hpp"
+#include "nexus/exec/queue.hpp"
+#include "nexus/exec/task.hpp"
+#include "nexus/exec/thread.hpp"
+
+#include <any>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <latch>
+#include <new>
+
+// Built as its own executable, the replaced allocator counts every
+// allocation of the binary.
+
+namespace {
+
+std::atomic_size_t alloc_cnt{0};
+
+} // namespace
+
+[[gnu::noinline]] auto operator new(std::size_t size) -> void * {
+    alloc_cnt.fetch_add(1, std::memory_order_relaxed);
+    if (auto *ptr = std::malloc(size); ptr != nullptr) { // NOLINT
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+[[gnu::noinline]] auto operator delete(void *ptr) noexcept -> void {
+    std::free(ptr); // NOLINT
+}
+
+[[gnu::noinline]] auto operator delete(void *ptr,
+                                       std::size_t /*size*/) noexcept -> void {
+    std::free(ptr); // NOLINT
+}
+
+namespace {
+
+namespace builder = nexus::exec::thread_builder;
+
+using nexus::exec::Task;
+using nexus::exec::TaskPolicy;
+using nexus::exec::TaskQueue;
+
+TEST(TaskAlloc, NoAllocation) {
+    constexpr static int TASK_CNT = 1000;
+
+    auto run_tasks = []() {
+        auto sum = 0;
+        for (int i = 0; i < TASK_CNT; ++i) {
+            auto task = Task<int>([i](int arg) { return i + arg; }, 1);
+            auto future = task.get_future();
+            task();
+            sum += future.get();
+
+            auto any_task = Task<>([i]() { return i; });
+            auto any_future = any_task.get_future();
+            any_task();
+            sum += std::any_cast<int>(any_future.get());
+        }
+        return sum;
+    };
+
+    // Fill the task pool first.
+    run_tasks();
+
+    auto before = alloc_cnt.load();
+    auto sum = run_tasks();
+    auto after = alloc_cnt.load();
+
+    EXPECT_EQ(sum, TASK_CNT * TASK_CNT);
+    EXPECT_EQ(after - before, 0);
+}
+
+// Tasks posted to a warm queue reuse its slots and the task pool.
+TEST(TaskAlloc, QueuePost) {
+    constexpr static int TASK_CNT = 1000;
+
+    for (auto policy : {TaskPolicy::FIFO, TaskPolicy::LIFO, TaskPolicy::PRIO,
+                        TaskPolicy::RING, TaskPolicy::STEAL}) {
+        auto queue = TaskQueue(policy);
+        queue.attach();
+
+        auto sum = 0;
+        auto run_tasks = [&queue, &sum]() {
+            for (int i = 0; i < TASK_CNT; ++i) {
+                queue.post([&sum](int arg) { sum += arg; }, 1);
+            }
+            for (int i = 0; i < TASK_CNT; ++i) {
+                queue.pop()();
+            }
+        };
+
+        run_tasks();
+
+        auto before = alloc_cnt.load();
+        run_tasks();
+        auto after = alloc_cnt.load();
+
+        queue.detach();
+
+        EXPECT_EQ(sum, 2 * TASK_CNT);
+        EXPECT_EQ(after - before, 0) << "policy " << static_cast<int>(policy);
+    }
+}
+
+// Tasks posted to a warm pool allocate nothing on the submitting thread or on
+// the workers.
+TEST(TaskAlloc, PoolPost) {
+    constexpr static int TASK_CNT = 1000;
+
+    for (auto policy : {TaskPolicy::FIFO, TaskPolicy::STEAL}) {
+        auto pool = builder::blank()
+                        .policy(policy)
+                        .max_workers(2)
+                        .init_workers(2)
+                        .build();
+
+        auto sum = std::atomic_int(0);
+        auto run_tasks = [&pool, &sum]() {
+            auto done = std::latch(TASK_CNT);
+            for (int i = 0; i < TASK_CNT; ++i) {
+                pool.post(
+                    [&done, &sum](int arg) {
+                        sum.fetch_add(arg, std::memory_order_relaxed);
+                        done.count_down();
+                    },
+                    1);
+            }
+            done.wait();
+        };
+
+        run_tasks();
+
+        auto before = alloc_cnt.load();
+        run_tasks();
+        auto after = alloc_cnt.load();
+
+        EXPECT_EQ(sum.load(), 2 * TASK_CNT);
+        EXPECT_EQ(after - before, 0) << "policy " << static_cast<int>(policy);
+    }
+}
+
+} // namespace
@@ -0,0 +1,136 @@
+#include "nexus/exec/thread.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <latch>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+namespace builder = nexus::exec::thread_builder;
+namespace exec = nexus::exec;
+
+using Clock = std::chrono::steady_clock;
+using std::chrono::milliseconds;
+
+TEST(Timer, After) {
+    auto pool = builder::common().build();
+    auto done = std::latch(3);
+
+    auto start = Clock::now();
+    auto short_at = Clock::time_point();
+    auto long_at = Clock::time_point();
+
+    pool.schedule_after(milliseconds(20), [&]() {
+        short_at = Clock::now();
+        done.count_down();
+    });
+    // Cascades from the second level of the wheel.
+    pool.schedule_after(milliseconds(300), [&]() {
+        long_at = Clock::now();
+        done.count_down();
+    });
+    // Past deadlines are posted at once.
+    pool.schedule_at(start - milliseconds(10), [&]() { done.count_down(); });
+
+    done.wait();
+    EXPECT_GE(short_at - start, milliseconds(20));
+    EXPECT_GE(long_at - start, milliseconds(300));
+    EXPECT_EQ(pool.timers(), 0);
+}
+
+TEST(Timer, Order) {
+    auto pool = builder::blank().max_workers(1).init_workers(1).build();
+    auto done = std::latch(4);
+    auto lock = std::mutex();
+    auto order = std::vector<int>();
+
+    for (int delay : {40, 10, 30, 20}) {
+        pool.schedule_after(milliseconds(delay), [&, delay]() {
+            {
+                auto guard = std::lock_guard(lock);
+                order.push_back(delay);
+            }
+            done.count_down();
+        });
+    }
+
+    done.wait();
+    EXPECT_EQ(order, (std::vector<int>{10, 20, 30, 40}));
+}
+
+TEST(Timer, Cancel) {
+    auto pool = builder::common().build();
+    auto called = std::atomic_bool(false);
+
+    auto timer =
+        pool.schedule_after(milliseconds(30), [&]() { called.store(true); });
+    auto far = pool.schedule_after(std::chrono::hours(24 * 365), []() {});
+    EXPECT_EQ(pool.timers(), 2);
+
+    EXPECT_TRUE(timer.cancel());
+    EXPECT_FALSE(timer.cancel());
+    EXPECT_TRUE(far.cancel());
+    EXPECT_EQ(pool.timers(), 0);
+
+    std::this_thread::sleep_for(milliseconds(60));
+    EXPECT_FALSE(called.load());
+    EXPECT_FALSE(exec::TimerHandle().cancel());
+}
+
+TEST(Timer, Every) {
+    auto pool = builder::common().build();
+    auto runs = std::atomic_int(0);
+
+    auto timer =
+        pool.schedule_every(milliseconds(5), [&]() { runs.fetch_add(1); });
+    while (runs.load() < 3) {
+        std::this_thread::sleep_for(milliseconds(1));
+    }
+
+    EXPECT_TRUE(timer.cancel());
+    std::this_thread::sleep_for(milliseconds(20));
+    auto stopped = runs.load();
+    std::this_thread::sleep_for(milliseconds(20));
+    EXPECT_EQ(runs.load(), stopped);
+
+    EXPECT_THROW(pool.schedule_every(milliseconds(0), []() {}),
+                 std::invalid_argument);
+}
+
+TEST(Timer, Many) {
+    constexpr static std::size_t TIMERS = 100000;
+
+    auto pool = builder::common().build();
+    auto fired = std::atomic_size_t(0);
+    auto gen = std::mt19937(42);
+    auto delay = std::uniform_int_distribution<int>(1, 600);
+
+    auto timers = std::vector<exec::TimerHandle>();
+    timers.reserve(TIMERS);
+    for (std::size_t i = 0; i < TIMERS; ++i) {
+        timers.push_back(pool.schedule_after(milliseconds(delay(gen)), [&]() {
+            fired.fetch_add(1, std::memory_order_relaxed);
+        }));
+    }
+
+    // Cancel every other timer, the ones already started are counted.
+    std::size_t cancelled = 0;
+    for (std::size_t i = 0; i < TIMERS; i += 2) {
+        cancelled += timers[i].cancel() ? 1 : 0;
+    }
+
+    while (fired.load() + cancelled < TIMERS) {
+        std::this_thread::sleep_for(milliseconds(10));
+    }
+    EXPECT_EQ(fired.load() + cancelled, TIMERS);
+    EXPECT_EQ(pool.timers(), 0);
+}
+
+} // namespace